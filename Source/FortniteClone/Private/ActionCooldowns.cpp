@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActionCooldowns.h"
+
+FActionCooldowns::FActionCooldowns() {
+	CancelAll();
+}
+
+bool FActionCooldowns::IsActive(EPlayerAction Action, float Now) const {
+	return Now < NextAllowedTime[(int)Action];
+}
+
+bool FActionCooldowns::IsAnyActive(float Now) const {
+	for (int i = 0; i < ActionCount; i++) {
+		if (Now < NextAllowedTime[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void FActionCooldowns::Start(EPlayerAction Action, float Now, float Duration) {
+	NextAllowedTime[(int)Action] = Now + Duration;
+}
+
+void FActionCooldowns::Cancel(EPlayerAction Action) {
+	NextAllowedTime[(int)Action] = 0;
+}
+
+void FActionCooldowns::CancelAll() {
+	for (int i = 0; i < ActionCount; i++) {
+		NextAllowedTime[i] = 0;
+	}
+}
@@ -7,6 +7,8 @@ AAmmunitionActor::AAmmunitionActor()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// ammunition placed in the map never changes until it is picked up
+	NetDormancy = DORM_Initial;
 
 }
 
@@ -0,0 +1,274 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BandwidthAccounting.h"
+#include "FortniteClone.h"
+#include "FortniteCloneGameMode.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "Engine/NetConnection.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UnrealType.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Accounted Bytes Sent"), STAT_AccountedBytesSent, STATGROUP_FortniteClone);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Accounted RPC Bytes Sent"), STAT_AccountedRPCBytesSent, STATGROUP_FortniteClone);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Estimated Property Bytes Sent"), STAT_EstimatedPropertyBytesSent, STATGROUP_FortniteClone);
+
+namespace
+{
+	const TCHAR* CategoryNames[] = {
+		TEXT("Connection"),
+		TEXT("RPC"),
+		TEXT("Property")
+	};
+	static_assert(ARRAY_COUNT(CategoryNames) == (int)EBandwidthCategory::Count, "every bandwidth category needs a name");
+
+	const double SecondsPerMinute = 60.0;
+
+	/* Payload bits of one element, strings and arrays are sized by their contents */
+	int64 EstimateBits(UProperty* Property, const void* Value) {
+		if (Property->IsA<UBoolProperty>()) {
+			return 1;
+		}
+		if (UStrProperty* StrProperty = Cast<UStrProperty>(Property)) {
+			// length prefix and the characters
+			return (4 + StrProperty->GetPropertyValue(Value).Len()) * 8;
+		}
+		if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property)) {
+			FScriptArrayHelper Helper(ArrayProperty, Value);
+			return (2 + Helper.Num() * ArrayProperty->Inner->ElementSize) * 8;
+		}
+		return Property->ElementSize * 8;
+	}
+
+	void SortByBits(TArray<TPair<FString, int64>>& Rows, const TMap<FString, int64>& Totals) {
+		for (const TPair<FString, int64>& Total : Totals) {
+			Rows.Add(Total);
+		}
+		Rows.Sort([](const TPair<FString, int64>& A, const TPair<FString, int64>& B) { return A.Value > B.Value; });
+	}
+}
+
+FBandwidthAccounting::FBandwidthAccounting()
+{
+	Enabled = FParse::Param(FCommandLine::Get(), TEXT("netaccounting"));
+	Minute = 0;
+	MinuteStartTime = -1;
+}
+
+FBandwidthAccounting& FBandwidthAccounting::Get() {
+	static FBandwidthAccounting Accounting;
+	return Accounting;
+}
+
+bool FBandwidthAccounting::IsEnabled() const {
+	return Enabled;
+}
+
+void FBandwidthAccounting::SetEnabled(bool NewEnabled) {
+	if (Enabled == NewEnabled) {
+		return;
+	}
+	if (!NewEnabled) {
+		Flush();
+		ClearSnapshots();
+	}
+	Enabled = NewEnabled;
+}
+
+void FBandwidthAccounting::AddConnectionBits(UNetConnection* Connection, int64 Bits) {
+	if (Bits <= 0) {
+		return;
+	}
+	Add(EBandwidthCategory::Connection, GetConnectionName(Connection), Bits);
+	INC_DWORD_STAT_BY(STAT_AccountedBytesSent, Bits / 8);
+}
+
+void FBandwidthAccounting::AddRPCBits(UFunction* Function, UNetConnection* Connection, int64 Bits) {
+	if (Bits <= 0) {
+		return;
+	}
+	// the owning class keeps RPCs with the same name on different actors apart
+	Add(EBandwidthCategory::RPC, Function->GetOuter()->GetName() + TEXT(".") + Function->GetName(), Bits);
+	AddConnectionBits(Connection, Bits);
+	INC_DWORD_STAT_BY(STAT_AccountedRPCBytesSent, Bits / 8);
+}
+
+void FBandwidthAccounting::SampleProperties(AActor* Actor, int OpenChannels) {
+	SampleObject(Actor, OpenChannels);
+	// components replicate through the actor's channel, like the inventory on the player state
+	for (UActorComponent* Component : Actor->GetReplicatedComponents()) {
+		if (Component && Component->GetIsReplicated()) {
+			SampleObject(Component, OpenChannels);
+		}
+	}
+}
+
+void FBandwidthAccounting::SampleObject(UObject* Object, int OpenChannels) {
+	TArray<FPropertySnapshot>* ObjectSnapshots = Snapshots.Find(Object);
+	if (ObjectSnapshots == nullptr) {
+		// the first sample only takes the copies, the initial bunch is not charged
+		ObjectSnapshots = &Snapshots.Add(Object);
+		TArray<FLifetimeProperty> LifetimeProperties;
+		Object->GetLifetimeReplicatedProps(LifetimeProperties);
+		for (TFieldIterator<UProperty> It(Object->GetClass()); It; ++It) {
+			UProperty* Property = *It;
+			if (!Property->HasAnyPropertyFlags(CPF_Net)) {
+				continue;
+			}
+			FPropertySnapshot Snapshot;
+			Snapshot.Property = Property;
+			Snapshot.Condition = COND_None;
+			for (const FLifetimeProperty& LifetimeProperty : LifetimeProperties) {
+				if (LifetimeProperty.RepIndex == Property->RepIndex) {
+					Snapshot.Condition = LifetimeProperty.Condition;
+					break;
+				}
+			}
+			Snapshot.Value = (uint8*)FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+			Property->InitializeValue(Snapshot.Value);
+			Property->CopyCompleteValue(Snapshot.Value, Property->ContainerPtrToValuePtr<void>(Object));
+			ObjectSnapshots->Add(Snapshot);
+		}
+		return;
+	}
+	for (FPropertySnapshot& Snapshot : *ObjectSnapshots) {
+		UProperty* Property = Snapshot.Property;
+		int64 Bits = 0;
+		for (int i = 0; i < Property->ArrayDim; i++) {
+			const void* Current = Property->ContainerPtrToValuePtr<void>(Object, i);
+			if (!Property->Identical(Current, Snapshot.Value + i * Property->ElementSize)) {
+				Bits += EstimateBits(Property, Current);
+			}
+		}
+		if (Bits == 0) {
+			continue;
+		}
+		Property->CopyCompleteValue(Snapshot.Value, Property->ContainerPtrToValuePtr<void>(Object));
+		const int Channels = GetReceivingChannels(Snapshot.Condition, OpenChannels);
+		if (Channels > 0) {
+			Add(EBandwidthCategory::Property, Object->GetClass()->GetName() + TEXT(".") + Property->GetName(), Bits * Channels);
+			INC_DWORD_STAT_BY(STAT_EstimatedPropertyBytesSent, Bits * Channels / 8);
+		}
+	}
+}
+
+int FBandwidthAccounting::GetReceivingChannels(ELifetimeCondition Condition, int OpenChannels) {
+	switch (Condition) {
+	case COND_OwnerOnly:
+	case COND_AutonomousOnly:
+	case COND_InitialOrOwner:
+	case COND_ReplayOrOwner:
+		// only the owning connection
+		return FMath::Min(OpenChannels, 1);
+	case COND_SkipOwner:
+	case COND_SimulatedOnly:
+	case COND_SimulatedOnlyNoReplay:
+		return FMath::Max(OpenChannels - 1, 0);
+	case COND_InitialOnly:
+	case COND_ReplayOnly:
+		// nothing after the initial bunch goes to a client
+		return 0;
+	default:
+		return OpenChannels;
+	}
+}
+
+void FBandwidthAccounting::Tick(double Now) {
+	if (MinuteStartTime < 0) {
+		MinuteStartTime = Now;
+	}
+	if (Now - MinuteStartTime >= SecondsPerMinute) {
+		Flush();
+		MinuteStartTime = Now;
+	}
+}
+
+void FBandwidthAccounting::Dump(int MaxRows) const {
+	for (int Category = 0; Category < CategoryCount; Category++) {
+		TMap<FString, int64> Minutes;
+		for (const TPair<FString, FBandwidthTotal>& Total : MinuteTotals[Category]) {
+			Minutes.Add(Total.Key, Total.Value.Bits);
+		}
+		TMap<FString, int64> Recording;
+		for (const TPair<FString, FBandwidthTotal>& Total : RecordingTotals[Category]) {
+			Recording.Add(Total.Key, Total.Value.Bits);
+		}
+		// the recording totals don't include the minute in progress until it is flushed
+		for (const TPair<FString, int64>& Total : Minutes) {
+			Recording.FindOrAdd(Total.Key) += Total.Value;
+		}
+		TArray<TPair<FString, int64>> Rows;
+		SortByBits(Rows, Recording);
+		UE_LOG(LogMyServer, Log, TEXT("%s bytes, this minute / whole recording:"), CategoryNames[Category]);
+		for (int i = 0; i < Rows.Num() && i < MaxRows; i++) {
+			const int64* MinuteBits = Minutes.Find(Rows[i].Key);
+			UE_LOG(LogMyServer, Log, TEXT("  %-60s %12lld %12lld"), *Rows[i].Key, MinuteBits ? *MinuteBits / 8 : 0, Rows[i].Value / 8);
+		}
+	}
+}
+
+void FBandwidthAccounting::Flush() {
+	bool Empty = true;
+	for (int Category = 0; Category < CategoryCount; Category++) {
+		Empty &= MinuteTotals[Category].Num() == 0;
+	}
+	if (Empty) {
+		return;
+	}
+	FString Csv;
+	if (CsvPath.IsEmpty()) {
+		// one file per recording, every minute appends to it
+		CsvPath = FPaths::ProfilingDir() / FString::Printf(TEXT("Bandwidth_%s.csv"), *FDateTime::Now().ToString());
+		Csv = TEXT("Minute,Category,Name,Bytes,Count\n");
+	}
+	for (int Category = 0; Category < CategoryCount; Category++) {
+		for (const TPair<FString, FBandwidthTotal>& Total : MinuteTotals[Category]) {
+			Csv += FString::Printf(TEXT("%d,%s,%s,%lld,%d\n"), Minute, CategoryNames[Category], *Total.Key, Total.Value.Bits / 8, Total.Value.Count);
+			FBandwidthTotal& RecordingTotal = RecordingTotals[Category].FindOrAdd(Total.Key);
+			RecordingTotal.Bits += Total.Value.Bits;
+			RecordingTotal.Count += Total.Value.Count;
+		}
+		MinuteTotals[Category].Reset();
+	}
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append)) {
+		UE_LOG(LogMyServer, Warning, TEXT("Could not write bandwidth totals to %s"), *CsvPath);
+	}
+	Minute++;
+	PurgeSnapshots();
+}
+
+void FBandwidthAccounting::Add(EBandwidthCategory Category, const FString& Name, int64 Bits) {
+	FBandwidthTotal& Total = MinuteTotals[(int)Category].FindOrAdd(Name);
+	Total.Bits += Bits;
+	Total.Count++;
+}
+
+FString FBandwidthAccounting::GetConnectionName(UNetConnection* Connection) {
+	return Connection->LowLevelGetRemoteAddress(true);
+}
+
+void FBandwidthAccounting::PurgeSnapshots() {
+	for (auto It = Snapshots.CreateIterator(); It; ++It) {
+		if (It.Key().IsValid()) {
+			continue;
+		}
+		for (FPropertySnapshot& Snapshot : It.Value()) {
+			Snapshot.Property->DestroyValue(Snapshot.Value);
+			FMemory::Free(Snapshot.Value);
+		}
+		It.RemoveCurrent();
+	}
+}
+
+void FBandwidthAccounting::ClearSnapshots() {
+	for (TPair<TWeakObjectPtr<UObject>, TArray<FPropertySnapshot>>& ObjectSnapshots : Snapshots) {
+		for (FPropertySnapshot& Snapshot : ObjectSnapshots.Value) {
+			Snapshot.Property->DestroyValue(Snapshot.Value);
+			FMemory::Free(Snapshot.Value);
+		}
+	}
+	Snapshots.Reset();
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BuildGrid.h"
+
+const float FBuildGrid::CellSize = 400.0f;
+const float FBuildGrid::PieceThickness = 20.0f;
+
+namespace
+{
+	// each coordinate gets 20 bits, offset so negative cells pack as well, the slot takes the low 2 bits
+	const int32 CoordBits = 20;
+	const int32 CoordOffset = 1 << (CoordBits - 1);
+	const uint64 CoordMask = (1ull << CoordBits) - 1;
+	const int32 SlotBits = 2;
+}
+
+uint64 FBuildGrid::MakeSlotKey(int32 X, int32 Y, int32 Z, EBuildSlot Slot) {
+	uint64 Key = (uint64)Slot;
+	Key |= ((uint64)(X + CoordOffset) & CoordMask) << SlotBits;
+	Key |= ((uint64)(Y + CoordOffset) & CoordMask) << (SlotBits + CoordBits);
+	Key |= ((uint64)(Z + CoordOffset) & CoordMask) << (SlotBits + CoordBits * 2);
+	return Key;
+}
+
+void FBuildGrid::BreakSlotKey(uint64 SlotKey, int32& OutX, int32& OutY, int32& OutZ, EBuildSlot& OutSlot) {
+	OutSlot = (EBuildSlot)(SlotKey & ((1ull << SlotBits) - 1));
+	OutX = (int32)((SlotKey >> SlotBits) & CoordMask) - CoordOffset;
+	OutY = (int32)((SlotKey >> (SlotBits + CoordBits)) & CoordMask) - CoordOffset;
+	OutZ = (int32)((SlotKey >> (SlotBits + CoordBits * 2)) & CoordMask) - CoordOffset;
+}
+
+uint64 FBuildGrid::SnapToSlot(int PieceIndex, const FVector& DesiredLocation, const FRotator& Facing, FTransform& OutTransform) {
+	// snap the facing to the closest axis, the pieces are modelled rotated 90 degrees from the character
+	const float SnappedYaw = FMath::RoundToFloat(Facing.Yaw / 90.0f) * 90.0f;
+	const bool FacingX = FMath::Abs(FMath::Cos(FMath::DegreesToRadians(SnappedYaw))) > 0.5f;
+	int32 X = FMath::FloorToInt(DesiredLocation.X / CellSize);
+	int32 Y = FMath::FloorToInt(DesiredLocation.Y / CellSize);
+	int32 Z = FMath::FloorToInt(DesiredLocation.Z / CellSize);
+	EBuildSlot Slot = EBuildSlot::Ramp;
+	FVector SnappedLocation((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize, (Z + 0.5f) * CellSize);
+	if (PieceIndex == 0) {
+		// walls sit on the cell face closest to the desired location along the facing axis
+		if (FacingX) {
+			Slot = EBuildSlot::WallX;
+			X = FMath::RoundToInt(DesiredLocation.X / CellSize);
+			SnappedLocation.X = X * CellSize;
+		}
+		else {
+			Slot = EBuildSlot::WallY;
+			Y = FMath::RoundToInt(DesiredLocation.Y / CellSize);
+			SnappedLocation.Y = Y * CellSize;
+		}
+	}
+	else if (PieceIndex == 2) {
+		// floors sit on the closest horizontal cell face
+		Slot = EBuildSlot::Floor;
+		Z = FMath::RoundToInt(DesiredLocation.Z / CellSize);
+		SnappedLocation.Z = Z * CellSize;
+	}
+	OutTransform = FTransform(FRotator(0, SnappedYaw + 90, 0), SnappedLocation);
+	return MakeSlotKey(X, Y, Z, Slot);
+}
+
+FBox FBuildGrid::GetSlotBounds(uint64 SlotKey) {
+	int32 X, Y, Z;
+	EBuildSlot Slot;
+	BreakSlotKey(SlotKey, X, Y, Z, Slot);
+	const FVector CellMin(X * CellSize, Y * CellSize, Z * CellSize);
+	const FVector CellMax = CellMin + FVector(CellSize);
+	const float HalfThickness = PieceThickness * 0.5f;
+	switch (Slot) {
+	case EBuildSlot::Floor:
+		return FBox(FVector(CellMin.X, CellMin.Y, CellMin.Z - HalfThickness), FVector(CellMax.X, CellMax.Y, CellMin.Z + HalfThickness));
+	case EBuildSlot::WallX:
+		return FBox(FVector(CellMin.X - HalfThickness, CellMin.Y, CellMin.Z), FVector(CellMin.X + HalfThickness, CellMax.Y, CellMax.Z));
+	case EBuildSlot::WallY:
+		return FBox(FVector(CellMin.X, CellMin.Y - HalfThickness, CellMin.Z), FVector(CellMax.X, CellMin.Y + HalfThickness, CellMax.Z));
+	default:
+		return FBox(CellMin, CellMax);
+	}
+}
+
+bool FBuildGrid::CapsuleIntersectsBox(const FVector& CapsuleCenter, float Radius, float HalfHeight, const FBox& Box) {
+	// an upright capsule is a vertical segment with a radius, the closest distance to a box separates per axis
+	const float SegmentHalfLength = FMath::Max(HalfHeight - Radius, 0.0f);
+	const float DX = FMath::Max3(Box.Min.X - CapsuleCenter.X, 0.0f, CapsuleCenter.X - Box.Max.X);
+	const float DY = FMath::Max3(Box.Min.Y - CapsuleCenter.Y, 0.0f, CapsuleCenter.Y - Box.Max.Y);
+	const float DZ = FMath::Max3(Box.Min.Z - (CapsuleCenter.Z + SegmentHalfLength), 0.0f, (CapsuleCenter.Z - SegmentHalfLength) - Box.Max.Z);
+	return DX * DX + DY * DY + DZ * DZ < Radius * Radius;
+}
+
+bool FBuildGrid::CapsuleIntersectsPiece(uint64 SlotKey, const FTransform& PieceTransform, const FVector& CapsuleCenter, float Radius, float HalfHeight) {
+	const FBox SlotBounds = GetSlotBounds(SlotKey);
+	if (!CapsuleIntersectsBox(CapsuleCenter, Radius, HalfHeight, SlotBounds)) {
+		return false;
+	}
+	if ((EBuildSlot)(SlotKey & ((1ull << SlotBits) - 1)) != EBuildSlot::Ramp) {
+		return true;
+	}
+	// a ramp is a slab through the cell center climbing one cell per cell along the builder's facing, undo the 90 degrees the pieces are modelled at
+	const FVector Climb = FRotator(0, PieceTransform.Rotator().Yaw - 90, 0).Vector();
+	const FVector Normal = FVector(-Climb.X, -Climb.Y, 1.0f).GetSafeNormal();
+	const FVector Center = SlotBounds.GetCenter();
+	const float SegmentHalfLength = FMath::Max(HalfHeight - Radius, 0.0f);
+	const float TopDistance = FVector::DotProduct(Normal, CapsuleCenter + FVector(0, 0, SegmentHalfLength) - Center);
+	const float BottomDistance = FVector::DotProduct(Normal, CapsuleCenter - FVector(0, 0, SegmentHalfLength) - Center);
+	// the segment crosses the slope if the ends are on different sides, otherwise the closest end decides
+	const float Distance = TopDistance * BottomDistance <= 0 ? 0.0f : FMath::Min(FMath::Abs(TopDistance), FMath::Abs(BottomDistance));
+	return Distance < Radius + PieceThickness * 0.5f;
+}
+
+bool FBuildGrid::IsOccupied(uint64 SlotKey) const {
+	return OccupiedSlots.Contains(SlotKey);
+}
+
+void FBuildGrid::Occupy(uint64 SlotKey) {
+	OccupiedSlots.Add(SlotKey);
+}
+
+void FBuildGrid::Release(uint64 SlotKey) {
+	OccupiedSlots.Remove(SlotKey);
+}
+
+void FBuildGrid::Reset() {
+	OccupiedSlots.Empty();
+}
@@ -2,6 +2,7 @@
 
 #include "BuildingActor.h"
 #include "UnrealNetwork.h"
+#include "FortniteCloneGameMode.h"
 
 // Sets default values
 ABuildingActor::ABuildingActor()
@@ -9,6 +10,10 @@ ABuildingActor::ABuildingActor()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
+	BuildGridSlot = 0;
+	InBuildGrid = false;
+	// pieces replicate once when built and then only when their health changes
+	NetDormancy = DORM_DormantAll;
 }
 
 // Called when the game starts or when spawned
@@ -18,6 +23,18 @@ void ABuildingActor::BeginPlay()
 	
 }
 
+void ABuildingActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+	if (HasAuthority() && InBuildGrid) {
+		AFortniteCloneGameMode* GameMode = GetWorld()->GetAuthGameMode<AFortniteCloneGameMode>();
+		if (GameMode) {
+			GameMode->BuildGrid.Release(BuildGridSlot);
+		}
+		InBuildGrid = false;
+	}
+}
+
 // Called every frame
 void ABuildingActor::Tick(float DeltaTime)
 {
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CharacterSignificanceManager.h"
+#include "FortniteClone.h"
+#include "FortniteCloneCharacter.h"
+#include "FortniteCloneReplicationGraph.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("High Significance Characters"), STAT_HighSignificanceCharacters, STATGROUP_FortniteClone);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Medium Significance Characters"), STAT_MediumSignificanceCharacters, STATGROUP_FortniteClone);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low Significance Characters"), STAT_LowSignificanceCharacters, STATGROUP_FortniteClone);
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_SignificanceUpdate, STATGROUP_FortniteClone);
+
+UCharacterSignificanceManager::UCharacterSignificanceManager()
+{
+	HighDistance = 3000.0f;
+	MediumDistance = 10000.0f;
+	CombatGraceTime = 2.0f;
+	NetUpdateFrequencies[(int)ESignificanceBucket::High] = 100.0f;
+	NetUpdateFrequencies[(int)ESignificanceBucket::Medium] = 30.0f;
+	NetUpdateFrequencies[(int)ESignificanceBucket::Low] = 10.0f;
+	TickIntervals[(int)ESignificanceBucket::High] = 0.0f;
+	TickIntervals[(int)ESignificanceBucket::Medium] = 0.033f;
+	TickIntervals[(int)ESignificanceBucket::Low] = 0.1f;
+	AnimationIntervals[(int)ESignificanceBucket::High] = 0.0f;
+	AnimationIntervals[(int)ESignificanceBucket::Medium] = 0.033f;
+	AnimationIntervals[(int)ESignificanceBucket::Low] = 0.1f;
+}
+
+void UCharacterSignificanceManager::Update() {
+	SCOPE_CYCLE_COUNTER(STAT_SignificanceUpdate);
+	UWorld* World = GetWorld();
+	if (World == nullptr) {
+		return;
+	}
+	const bool IsServer = World->GetNetMode() < NM_Client;
+	UFortniteCloneReplicationGraph* ReplicationGraph = IsServer ? UFortniteCloneReplicationGraph::Get(World) : nullptr;
+	AGameStateBase* GameState = World->GetGameState();
+	const float Now = GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+
+	// the server ranks against every player, a client only against its own view
+	ViewerLocations.Reset();
+	ViewerCharacters.Reset();
+	if (IsServer) {
+		for (TActorIterator<AFortniteCloneCharacter> It(World); It; ++It) {
+			if (It->IsPlayerControlled()) {
+				ViewerLocations.Add(It->GetActorLocation());
+				ViewerCharacters.Add(*It);
+			}
+		}
+	}
+	else {
+		APlayerController* PlayerController = World->GetFirstPlayerController();
+		if (PlayerController == nullptr) {
+			return;
+		}
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		ViewerLocations.Add(ViewLocation);
+		ViewerCharacters.Add(nullptr);
+	}
+
+	uint32 BucketCounts[(int)ESignificanceBucket::Count] = { 0 };
+	for (TActorIterator<AFortniteCloneCharacter> It(World); It; ++It) {
+		AFortniteCloneCharacter* Character = *It;
+		if (Character->IsPendingKill() || (!IsServer && Character->IsLocallyControlled())) {
+			continue;
+		}
+		const FVector Location = Character->GetActorLocation();
+		float DistanceSquared = MAX_flt;
+		for (int i = 0; i < ViewerLocations.Num(); i++) {
+			if (ViewerCharacters[i] == Character) {
+				continue; // a player doesn't make itself significant
+			}
+			DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(ViewerLocations[i], Location));
+		}
+		// the server doesn't render, so nothing is out of view there
+		const bool Visible = IsServer || Character->WasRecentlyRendered(0.2f);
+		const ESignificanceBucket Bucket = GetBucket(Character, DistanceSquared, Visible, Now);
+		ApplyBucket(Character, Bucket, IsServer, ReplicationGraph);
+		BucketCounts[(int)Bucket]++;
+	}
+	SET_DWORD_STAT(STAT_HighSignificanceCharacters, BucketCounts[(int)ESignificanceBucket::High]);
+	SET_DWORD_STAT(STAT_MediumSignificanceCharacters, BucketCounts[(int)ESignificanceBucket::Medium]);
+	SET_DWORD_STAT(STAT_LowSignificanceCharacters, BucketCounts[(int)ESignificanceBucket::Low]);
+}
+
+ESignificanceBucket UCharacterSignificanceManager::GetBucket(AFortniteCloneCharacter* Character, float DistanceSquared, bool Visible, float Now) const {
+	const bool InCombat = Character->ActionEvent.GetMontage() != ECharacterMontage::None && Now - Character->ActionEvent.GetStartTime() < CombatGraceTime;
+	if (InCombat || DistanceSquared < HighDistance * HighDistance) {
+		return ESignificanceBucket::High;
+	}
+	if (Visible && DistanceSquared < MediumDistance * MediumDistance) {
+		return ESignificanceBucket::Medium;
+	}
+	return ESignificanceBucket::Low;
+}
+
+void UCharacterSignificanceManager::ApplyBucket(AFortniteCloneCharacter* Character, ESignificanceBucket Bucket, bool IsServer, UFortniteCloneReplicationGraph* ReplicationGraph) {
+	if (IsServer) {
+		// the frequency only matters to the legacy net driver, the graph keeps its own period per actor
+		Character->NetUpdateFrequency = NetUpdateFrequencies[(int)Bucket];
+		if (ReplicationGraph) {
+			ReplicationGraph->SetUpdateFrequency(Character, NetUpdateFrequencies[(int)Bucket]);
+		}
+		return;
+	}
+	// only simulated proxies get here, the local player always ticks every frame
+	Character->SetActorTickInterval(TickIntervals[(int)Bucket]);
+	if (Character->GetMesh()) {
+		Character->GetMesh()->SetComponentTickInterval(AnimationIntervals[(int)Bucket]);
+	}
+}
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FortniteCloneAssetManager.h"
+#include "FortniteCloneGameMode.h"
+#include "WeaponDefinition.h"
+#include "Engine/Engine.h"
+
+void UFortniteCloneAssetManager::StartInitialLoading() {
+	Super::StartInitialLoading();
+	// definitions are small and needed by the first shot, so they are loaded synchronously with the rest of startup
+	TArray<FSoftObjectPath> DefinitionPaths;
+	GetPrimaryAssetPathList(UWeaponDefinition::PrimaryAssetType, DefinitionPaths);
+	for (const FSoftObjectPath& DefinitionPath : DefinitionPaths) {
+		UWeaponDefinition* Definition = Cast<UWeaponDefinition>(DefinitionPath.TryLoad());
+		if (Definition == nullptr || Definition->WeaponId < 0) {
+			UE_LOG(LogMyServer, Warning, TEXT("Ignoring weapon definition %s"), *DefinitionPath.ToString());
+			continue;
+		}
+		if (WeaponTable.Num() <= Definition->WeaponId) {
+			WeaponTable.SetNumZeroed(Definition->WeaponId + 1);
+		}
+		if (WeaponTable[Definition->WeaponId]) {
+			UE_LOG(LogMyServer, Warning, TEXT("Weapon definitions %s and %s share weapon id %d"), *WeaponTable[Definition->WeaponId]->GetName(), *Definition->GetName(), Definition->WeaponId);
+			continue;
+		}
+		WeaponTable[Definition->WeaponId] = Definition;
+	}
+	AddBuiltInWeaponDefinitions();
+}
+
+UFortniteCloneAssetManager& UFortniteCloneAssetManager::Get() {
+	UFortniteCloneAssetManager* AssetManager = Cast<UFortniteCloneAssetManager>(GEngine->AssetManager);
+	check(AssetManager); // AssetManagerClassName in DefaultEngine.ini has to point at this class
+	return *AssetManager;
+}
+
+const UWeaponDefinition* UFortniteCloneAssetManager::GetWeaponDefinition(int WeaponId) {
+	const TArray<UWeaponDefinition*>& Table = Get().WeaponTable;
+	return Table.IsValidIndex(WeaponId) ? Table[WeaponId] : nullptr;
+}
+
+int UFortniteCloneAssetManager::GetWeaponCount() const {
+	return WeaponTable.Num();
+}
+
+void UFortniteCloneAssetManager::AddBuiltInWeaponDefinitions() {
+	const int BuiltInCount = 3;
+	if (WeaponTable.Num() < BuiltInCount) {
+		WeaponTable.SetNumZeroed(BuiltInCount);
+	}
+	if (WeaponTable[0] == nullptr) {
+		UWeaponDefinition* Pickaxe = NewObject<UWeaponDefinition>(this, TEXT("BuiltIn_Pickaxe"));
+		Pickaxe->WeaponId = 0;
+		Pickaxe->UsesAmmunition = false;
+		Pickaxe->FireInterval = 0.403f;
+		Pickaxe->ReloadTime = 0;
+		Pickaxe->FireAction = EPlayerAction::SwingPickaxe;
+		Pickaxe->FireMontage = ECharacterMontage::PickaxeSwing;
+		Pickaxe->AimedFireMontage = ECharacterMontage::PickaxeSwing;
+		Pickaxe->ReloadMontage = ECharacterMontage::None;
+		Pickaxe->AimedReloadMontage = ECharacterMontage::None;
+		WeaponTable[0] = Pickaxe;
+	}
+	if (WeaponTable[1] == nullptr) {
+		// the definition's defaults are the assault rifle
+		UWeaponDefinition* Rifle = NewObject<UWeaponDefinition>(this, TEXT("BuiltIn_AssaultRifle"));
+		Rifle->WeaponId = 1;
+		WeaponTable[1] = Rifle;
+	}
+	if (WeaponTable[2] == nullptr) {
+		UWeaponDefinition* Shotgun = NewObject<UWeaponDefinition>(this, TEXT("BuiltIn_Shotgun"));
+		Shotgun->WeaponId = 2;
+		Shotgun->FireInterval = 1.3f;
+		Shotgun->ReloadTime = 4.3f;
+		Shotgun->FireAction = EPlayerAction::ShootShotgun;
+		Shotgun->ReloadAction = EPlayerAction::ReloadShotgun;
+		Shotgun->FireMontage = ECharacterMontage::ShootShotgun;
+		Shotgun->AimedFireMontage = ECharacterMontage::ShootShotgunIronsights;
+		Shotgun->ReloadMontage = ECharacterMontage::ReloadShotgun;
+		Shotgun->AimedReloadMontage = ECharacterMontage::ReloadShotgunIronsights;
+		WeaponTable[2] = Shotgun;
+	}
+}
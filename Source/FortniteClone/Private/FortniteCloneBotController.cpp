@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FortniteCloneBotController.h"
+#include "FortniteCloneCharacter.h"
+#include "FortniteCloneCharacterMovement.h"
+#include "FortniteClonePlayerState.h"
+#include "FortniteCloneGameMode.h"
+#include "InventoryComponent.h"
+#include "StormActor.h"
+#include "WeaponActor.h"
+#include "FortniteCloneAssetManager.h"
+#include "EngineUtils.h"
+#include "TimerManager.h"
+
+AFortniteCloneBotController::AFortniteCloneBotController()
+{
+	// bots get a player state like real players so the inventory and cooldowns work the same way
+	bWantsPlayerState = true;
+	PrimaryActorTick.bCanEverTick = true;
+	Profile = EBotProfile::Wander;
+	ThinkInterval = 0.25f;
+	EngageDistance = 3000.0f;
+	Destination = FVector::ZeroVector;
+	HasDestination = false;
+	StrafeInput = 0;
+	Sprinting = false;
+}
+
+EBotProfile AFortniteCloneBotController::ParseProfile(const FString& Name) {
+	if (Name.Equals(TEXT("BuildFight"), ESearchCase::IgnoreCase)) {
+		return EBotProfile::BuildFight;
+	}
+	if (Name.Equals(TEXT("StormRush"), ESearchCase::IgnoreCase)) {
+		return EBotProfile::StormRush;
+	}
+	return EBotProfile::Wander;
+}
+
+void AFortniteCloneBotController::Possess(APawn* InPawn) {
+	Super::Possess(InPawn);
+	// spread the decisions of many bots over different frames
+	GetWorldTimerManager().SetTimer(ThinkTimerHandle, this, &AFortniteCloneBotController::Think, ThinkInterval, true, FMath::FRandRange(0.0f, ThinkInterval));
+}
+
+void AFortniteCloneBotController::Tick(float DeltaTime) {
+	Super::Tick(DeltaTime);
+	AFortniteCloneCharacter* Character = Cast<AFortniteCloneCharacter>(GetPawn());
+	if (Character == nullptr) {
+		return;
+	}
+	// a real player's key presses set these flags on the client, a bot sets them directly on the server
+	Character->GetFortniteCloneMovement()->bWantsToWalk = HasDestination || StrafeInput != 0;
+	Character->GetFortniteCloneMovement()->bWantsToRun = Sprinting;
+	if (HasDestination) {
+		Character->MoveForward(1.0f);
+	}
+	if (StrafeInput != 0) {
+		Character->MoveRight(StrafeInput);
+	}
+}
+
+void AFortniteCloneBotController::Think() {
+	AFortniteCloneCharacter* Character = Cast<AFortniteCloneCharacter>(GetPawn());
+	if (Character == nullptr || Character->IsPendingKill()) {
+		GetWorldTimerManager().ClearTimer(ThinkTimerHandle);
+		return;
+	}
+	ClearFocus(EAIFocusPriority::Gameplay);
+	switch (Profile) {
+	case EBotProfile::BuildFight:
+		ThinkBuildFight(Character);
+		break;
+	case EBotProfile::StormRush:
+		ThinkStormRush(Character);
+		break;
+	default:
+		ThinkWander(Character);
+		break;
+	}
+	if (HasDestination && GetFocusActor() == nullptr) {
+		SetFocalPoint(Destination);
+	}
+}
+
+void AFortniteCloneBotController::ThinkBuildFight(AFortniteCloneCharacter* Character) {
+	AFortniteCloneCharacter* Target = FindNearestEnemy(Character);
+	if (Target == nullptr) {
+		ThinkWander(Character);
+		return;
+	}
+	const float Distance = FVector::Dist(Character->GetActorLocation(), Target->GetActorLocation());
+	if (Distance > EngageDistance) {
+		Destination = Target->GetActorLocation();
+		HasDestination = true;
+		StrafeInput = 0;
+		Sprinting = true;
+		return;
+	}
+	// in range, strafe and alternate between putting up a wall and shooting
+	HasDestination = false;
+	Sprinting = false;
+	StrafeInput = FMath::RandBool() ? 1.0f : -1.0f;
+	AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(PlayerState);
+	if (State && FMath::RandRange(0, 3) == 0 && State->Inventory->GetCount(EInventoryItem::Material, Character->CurrentBuildingMaterial) >= 10) {
+		Character->ServerSetBuildModeWall();
+		Character->ServerBuildStructures();
+		Character->ServerSetBuildModeWall();
+		return;
+	}
+	Engage(Character, Target);
+}
+
+void AFortniteCloneBotController::ThinkStormRush(AFortniteCloneCharacter* Character) {
+	AFortniteCloneGameMode* GameMode = GetWorld()->GetAuthGameMode<AFortniteCloneGameMode>();
+	if (GameMode && GameMode->CurrentStorm) {
+		Destination = GameMode->CurrentStorm->Phase.Center;
+		Destination.Z = Character->GetActorLocation().Z;
+		HasDestination = FVector::DistSquared2D(Destination, Character->GetActorLocation()) > 500.0f * 500.0f;
+	}
+	else {
+		ThinkWander(Character);
+	}
+	Sprinting = HasDestination;
+	StrafeInput = 0;
+	AFortniteCloneCharacter* Target = FindNearestEnemy(Character);
+	if (Target && FVector::Dist(Character->GetActorLocation(), Target->GetActorLocation()) < EngageDistance) {
+		// slow down to shoot, the bot now moves the way it is aiming
+		Sprinting = false;
+		Engage(Character, Target);
+	}
+}
+
+void AFortniteCloneBotController::ThinkWander(AFortniteCloneCharacter* Character) {
+	Sprinting = false;
+	StrafeInput = 0;
+	// pickups happen by overlapping the weapon, the same as for a player
+	AActor* Loot = FindNearestLoot(Character, 5000.0f);
+	if (Loot) {
+		Destination = Loot->GetActorLocation();
+		HasDestination = true;
+		return;
+	}
+	if (!HasDestination || FVector::DistSquared2D(Destination, Character->GetActorLocation()) < 300.0f * 300.0f) {
+		Destination = Character->GetActorLocation() + FVector(FMath::FRandRange(-3000.0f, 3000.0f), FMath::FRandRange(-3000.0f, 3000.0f), 0);
+		HasDestination = true;
+	}
+}
+
+void AFortniteCloneBotController::Engage(AFortniteCloneCharacter* Character, AFortniteCloneCharacter* Target) {
+	SetFocus(Target);
+	AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(PlayerState);
+	if (State == nullptr) {
+		return;
+	}
+	// use the first gun owned in weapon table order, the pickaxe otherwise
+	int WeaponType = 0;
+	const int WeaponCount = UFortniteCloneAssetManager::Get().GetWeaponCount();
+	for (int i = 1; i < WeaponCount; i++) {
+		if (State->Inventory->HasWeapon(i)) {
+			WeaponType = i;
+			break;
+		}
+	}
+	if (State->CurrentWeapon != WeaponType || !State->HoldingWeapon) {
+		Character->ServerSwitchToWeapon(WeaponType);
+	}
+	Character->ServerFireWeapons();
+}
+
+AFortniteCloneCharacter* AFortniteCloneBotController::FindNearestEnemy(AFortniteCloneCharacter* Character) const {
+	AFortniteCloneCharacter* Nearest = nullptr;
+	float NearestDistanceSquared = MAX_flt;
+	for (TActorIterator<AFortniteCloneCharacter> It(GetWorld()); It; ++It) {
+		if (*It == Character || It->IsPendingKill() || It->Health <= 0) {
+			continue;
+		}
+		const float DistanceSquared = FVector::DistSquared(It->GetActorLocation(), Character->GetActorLocation());
+		if (DistanceSquared < NearestDistanceSquared) {
+			NearestDistanceSquared = DistanceSquared;
+			Nearest = *It;
+		}
+	}
+	return Nearest;
+}
+
+AActor* AFortniteCloneBotController::FindNearestLoot(AFortniteCloneCharacter* Character, float Range) const {
+	AActor* Nearest = nullptr;
+	float NearestDistanceSquared = Range * Range;
+	AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(PlayerState);
+	for (TActorIterator<AWeaponActor> It(GetWorld()); It; ++It) {
+		// a weapon type the bot already owns can't be picked up, walking to it would stall the bot on top of it
+		if (It->Holder != nullptr || It->WeaponType == 0 || It->bHidden || (State && State->Inventory->HasWeapon(It->WeaponType))) {
+			continue;
+		}
+		const float DistanceSquared = FVector::DistSquared(It->GetActorLocation(), Character->GetActorLocation());
+		if (DistanceSquared < NearestDistanceSquared) {
+			NearestDistanceSquared = DistanceSquared;
+			Nearest = *It;
+		}
+	}
+	return Nearest;
+}
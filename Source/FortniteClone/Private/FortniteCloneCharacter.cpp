@@ -21,12 +21,32 @@
 #include "FortniteCloneHUD.h"
 #include "StormActor.h"
 #include "FortniteClonePlayerController.h"
+#include "FortniteCloneCharacterMovement.h"
+#include "FortniteCloneGameMode.h"
+#include "BuildGrid.h"
+#include "ProjectileManager.h"
+#include "InventoryComponent.h"
+#include "HUDViewModel.h"
+#include "GameFramework/GameStateBase.h"
+#include "FortniteClone.h"
+#include "MatchProfiler.h"
+#include "MatchEventLog.h"
+#include "WeaponDefinition.h"
+#include "FortniteCloneAssetManager.h"
+#include "FortniteCloneReplicationGraph.h"
+#include "TracerActor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Tick"), STAT_CharacterTick, STATGROUP_FortniteClone);
+DECLARE_CYCLE_STAT(TEXT("Fire Weapons"), STAT_FireWeapons, STATGROUP_FortniteClone);
+DECLARE_CYCLE_STAT(TEXT("Build Structures"), STAT_BuildStructures, STATGROUP_FortniteClone);
+DECLARE_CYCLE_STAT(TEXT("Character Overlap"), STAT_CharacterOverlap, STATGROUP_FortniteClone);
 
 DEFINE_LOG_CATEGORY(LogMyGame);
 //////////////////////////////////////////////////////////////////////////
 // AFortniteCloneCharacter
 
-AFortniteCloneCharacter::AFortniteCloneCharacter()
+AFortniteCloneCharacter::AFortniteCloneCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UFortniteCloneCharacterMovement>(ACharacter::CharacterMovementComponentName))
 {
 	bReplicates = true;
 	// Set size for collision capsule
@@ -38,7 +58,6 @@ AFortniteCloneCharacter::AFortniteCloneCharacter()
 	TriggerCapsule->SetCollisionProfileName(TEXT("Trigger"));
 	TriggerCapsule->SetupAttachment(RootComponent);
 	TriggerCapsule->OnComponentBeginOverlap.AddDynamic(this, &AFortniteCloneCharacter::OnOverlapBegin);
-	TriggerCapsule->OnComponentEndOverlap.AddDynamic(this, &AFortniteCloneCharacter::OnOverlapEnd);
 
 	// set our turn rates for input
 	BaseTurnRate = 45.f;
@@ -67,8 +86,11 @@ AFortniteCloneCharacter::AFortniteCloneCharacter()
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
 	CurrentWeaponType = 0;
+	HealingItemPool = nullptr;
+	ActiveEquipmentSlot = 0;
 	CurrentBuildingMaterial = 0;
-	BuildingPreview = nullptr;
+	BuildingPreviews.Init(nullptr, 3);
+	BuildingPreviewMaterials.Init(-1, 3);
 
 	// Animinstance properties
 	IsWalking = false;
@@ -83,7 +105,12 @@ AFortniteCloneCharacter::AFortniteCloneCharacter()
 	WalkingY = 0;
 	RunningX = 0;
 	RunningY = 0;
+	ReplicatedAimPitch = 0.0;
+	ReplicatedAimYaw = 0.0;
 	InStorm = true;
+	HitboxHistoryHead = 0;
+	HitboxHistoryNum = 0;
+	BandageHealPending = false;
 
 	// Playerstate properties
 	/*InBuildMode = false;
@@ -173,16 +200,22 @@ void AFortniteCloneCharacter::BeginPlay() {
 		return;
 	}*/
 	if (HasAuthority()) {
-		if (WeaponClasses[CurrentWeaponType]) {
+		// the weapon table is loaded by the asset manager at startup, a slot per weapon id it knows about
+		WeaponPool.SetNumZeroed(UFortniteCloneAssetManager::Get().GetWeaponCount());
+		if (WeaponClasses.IsValidIndex(CurrentWeaponType) && WeaponClasses[CurrentWeaponType] && WeaponPool.IsValidIndex(CurrentWeaponType)) {
 			FName WeaponSocketName = TEXT("hand_right_socket");
 			FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
 			CurrentWeapon = GetWorld()->SpawnActor<AWeaponActor>(WeaponClasses[CurrentWeaponType], GetActorLocation(), GetActorRotation());
 			UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentWeapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
 			WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
 			CurrentWeapon->Holder = this;
+			CurrentWeapon->SetNetDormancy(DORM_Awake);
+			WeaponPool[CurrentWeaponType] = CurrentWeapon;
+			ActiveEquipmentSlot = CurrentWeaponType;
 			HoldingWeapon = true;
 			AimedIn = false;
 			HoldingWeaponType = 1;
+			UpdateEquipmentVisibility();
 		}
 		//find the storm and keep a reference to it for damage purposes
 		TArray<AActor*> StormActors;
@@ -192,9 +225,6 @@ void AFortniteCloneCharacter::BeginPlay() {
 				CurrentStorm = Cast<AStormActor>(StormActors[0]);
 			}
 		}
-		FTimerHandle StormDamageTimerHandle;
-		GetWorldTimerManager().SetTimer(StormDamageTimerHandle, this, &AFortniteCloneCharacter::ServerApplyStormDamage, 1.0f, true);
-
 	}
 
 	/*if (GetController()) {
@@ -208,6 +238,30 @@ void AFortniteCloneCharacter::BeginPlay() {
 	}*/
 }
 
+void AFortniteCloneCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	Super::EndPlay(EndPlayReason);
+	// previews are never replicated, so the client that spawned them has to clean them up
+	for (int i = 0; i < BuildingPreviews.Num(); i++) {
+		if (BuildingPreviews[i]) {
+			BuildingPreviews[i]->Destroy();
+			BuildingPreviews[i] = nullptr;
+		}
+	}
+	if (HasAuthority()) {
+		// pooled items that were not dropped go away with the character
+		for (int i = 0; i < WeaponPool.Num(); i++) {
+			if (WeaponPool[i] && WeaponPool[i]->Holder == this) {
+				WeaponPool[i]->Destroy();
+			}
+		}
+		WeaponPool.Reset();
+		if (HealingItemPool && HealingItemPool->Holder == this) {
+			HealingItemPool->Destroy();
+		}
+		HealingItemPool = nullptr;
+	}
+}
+
 void AFortniteCloneCharacter::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
@@ -233,9 +287,6 @@ bool AFortniteCloneCharacter::ReplicateSubobjects(class UActorChannel *Channel,
 	}
 	if (State != nullptr) {
 		WroteSomething |= Channel->ReplicateSubobject(State, *Bunch, *RepFlags);
-	}
-	if (BuildingPreview != nullptr) {
-		WroteSomething |= Channel->ReplicateSubobject(BuildingPreview, *Bunch, *RepFlags);
 	}*/
 	return WroteSomething;
 }
@@ -244,81 +295,27 @@ void AFortniteCloneCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProper
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AFortniteCloneCharacter, BuildingPreview);
 	DOREPLIFETIME(AFortniteCloneCharacter, CurrentBuildingMaterial);
 	DOREPLIFETIME(AFortniteCloneCharacter, CurrentHealingItem);
 	DOREPLIFETIME(AFortniteCloneCharacter, CurrentWeapon);
+	DOREPLIFETIME(AFortniteCloneCharacter, WeaponPool);
+	DOREPLIFETIME(AFortniteCloneCharacter, HealingItemPool);
+	DOREPLIFETIME(AFortniteCloneCharacter, ActiveEquipmentSlot);
 	DOREPLIFETIME(AFortniteCloneCharacter, CurrentStorm);
 	DOREPLIFETIME(AFortniteCloneCharacter, CurrentWeaponType);
 	DOREPLIFETIME(AFortniteCloneCharacter, Health);
 
-	DOREPLIFETIME(AFortniteCloneCharacter, IsWalking);
-	DOREPLIFETIME(AFortniteCloneCharacter, IsRunning);
-	DOREPLIFETIME(AFortniteCloneCharacter, WalkingX);
-	DOREPLIFETIME(AFortniteCloneCharacter, WalkingY);
-	DOREPLIFETIME(AFortniteCloneCharacter, RunningX);
-	DOREPLIFETIME(AFortniteCloneCharacter, RunningY);
-	DOREPLIFETIME(AFortniteCloneCharacter, HoldingWeapon);
-	DOREPLIFETIME(AFortniteCloneCharacter, HoldingWeaponType);
-	DOREPLIFETIME(AFortniteCloneCharacter, AimedIn);
-	DOREPLIFETIME(AFortniteCloneCharacter, AimPitch);
-	DOREPLIFETIME(AFortniteCloneCharacter, AimYaw);
-	DOREPLIFETIME(AFortniteCloneCharacter, InterpSpeed);
+	DOREPLIFETIME(AFortniteCloneCharacter, AnimState);
+	DOREPLIFETIME(AFortniteCloneCharacter, ActionEvent);
 	DOREPLIFETIME(AFortniteCloneCharacter, InStorm);
 }
 
 void AFortniteCloneCharacter::Tick(float DeltaTime) {
+	SCOPE_CYCLE_COUNTER(STAT_CharacterTick);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::CharacterTick);
 	Super::Tick(DeltaTime);
 	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("Tick mode ") + FString::FromInt(GetNetMode()));
-	FVector DirectionVector = FVector(0, AimYaw, AimPitch);
 	if (HasAuthority()) {
-		if (GetController()) {
-			AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-			if (State) {
-				if (State->InBuildMode && State->BuildMode == FString("Wall")) {
-					if (BuildingPreview) {
-						BuildingPreview->Destroy(); //destroy the last wall preview
-					}
-					FString LogMsg = FString("Current building material ") + FString::FromInt(CurrentBuildingMaterial);
-					UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-					if (CurrentBuildingMaterial >= 0 && CurrentBuildingMaterial <= 2) {
-						if (WallPreviewClasses.IsValidIndex(CurrentBuildingMaterial)) {
-							if (WallPreviewClasses[CurrentBuildingMaterial] != nullptr) {
-								BuildingPreview = GetWorld()->SpawnActor<ABuildingActor>(WallPreviewClasses[CurrentBuildingMaterial], GetActorLocation() + (GetActorForwardVector() * 200) + (DirectionVector * 3), GetActorRotation().Add(0, 90, 0)); //set the new wall preview
-							}
-						}
-					}
-				}
-				if (State->InBuildMode && State->BuildMode == FString("Ramp")) {
-					if (BuildingPreview) {
-						BuildingPreview->Destroy(); //destroy the last wall preview
-					}
-					FString LogMsg = FString("Current building material ") + FString::FromInt(CurrentBuildingMaterial);
-					UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-					if (CurrentBuildingMaterial >= 0 && CurrentBuildingMaterial <= 2) {
-						if (RampPreviewClasses.IsValidIndex(CurrentBuildingMaterial)) {
-							if (RampPreviewClasses[CurrentBuildingMaterial] != nullptr) {
-								BuildingPreview = GetWorld()->SpawnActor<ABuildingActor>(RampPreviewClasses[CurrentBuildingMaterial], GetActorLocation() + (GetActorForwardVector() * 100) + (DirectionVector * 3), GetActorRotation().Add(0, 90, 0)); //set the new ramp preview
-							}
-						}
-					}
-				}
-				if (State->InBuildMode && State->BuildMode == FString("Floor")) {
-					if (BuildingPreview) {
-						BuildingPreview->Destroy(); //destroy the last wall preview
-					}
-					FString LogMsg = FString("Current building material ") + FString::FromInt(CurrentBuildingMaterial);
-					UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-					if (CurrentBuildingMaterial >= 0 && CurrentBuildingMaterial <= 2) {
-						if (FloorPreviewClasses.IsValidIndex(CurrentBuildingMaterial)) {
-							if (FloorPreviewClasses[CurrentBuildingMaterial] != nullptr) {
-								BuildingPreview = GetWorld()->SpawnActor<ABuildingActor>(FloorPreviewClasses[CurrentBuildingMaterial], GetActorLocation() + (GetActorForwardVector() * 120) + (DirectionVector * 3), GetActorRotation().Add(0, 90, 0)); //set the new floor preview
-							}
-						}
-					}
-				}
-			}
-		}
 		FRotator ControlRotation = GetControlRotation();
 		FRotator ActorRotation = GetActorRotation();
 
@@ -333,11 +330,339 @@ void AFortniteCloneCharacter::Tick(float DeltaTime) {
 		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(NewPitch).Append(FString::FromInt(NewYaw)));
 		AimPitch = NewPitch;
 		AimYaw = NewYaw;
+		RecordHitboxSample(GetWorld()->GetTimeSeconds());
+		ApplyPendingBandageHeal();
+	}
+	else {
+		// smooth between the quantized aim updates so simulated proxies do not step
+		FRotator AimRotation = FRotator(AimPitch, AimYaw, 0);
+		FRotator TargetRotation = FRotator(ReplicatedAimPitch, ReplicatedAimYaw, 0);
+		FRotator InterpolatedRotation = FMath::RInterpTo(AimRotation, TargetRotation, DeltaTime, InterpSpeed);
+		AimPitch = InterpolatedRotation.Pitch;
+		AimYaw = InterpolatedRotation.Yaw;
+	}
+	if (IsLocallyControlled()) {
+		UpdateBuildingPreviews();
+	}
+}
+
+void AFortniteCloneCharacter::RecordHitboxSample(float Time) {
+	HitboxHistory[HitboxHistoryHead].Time = Time;
+	HitboxHistory[HitboxHistoryHead].Location = GetActorLocation();
+	HitboxHistoryHead = (HitboxHistoryHead + 1) % HitboxHistorySize;
+	HitboxHistoryNum = FMath::Min(HitboxHistoryNum + 1, HitboxHistorySize);
+}
+
+void AFortniteCloneCharacter::ApplyPendingBandageHeal() {
+	if (!BandageHealPending || GetController() == nullptr || !IsAlive()) {
+		return;
+	}
+	AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
+	if (State == nullptr || State->IsActionActive(EPlayerAction::UseBandage)) {
+		return;
+	}
+	BandageHealPending = false;
+	if (Health < 100) {
+		if (Health + 15 > 100) {
+			Health = 100;
+		}
+		else {
+			Health += 15;
+		}
+		OnRep_Health();
+	}
+}
+
+FVector AFortniteCloneCharacter::GetRewoundLocation(float Time) const {
+	if (HitboxHistoryNum == 0) {
+		return GetActorLocation();
+	}
+	// walk back from the newest sample until one is at or before the requested time
+	int Newer = (HitboxHistoryHead - 1 + HitboxHistorySize) % HitboxHistorySize;
+	if (Time >= HitboxHistory[Newer].Time) {
+		return HitboxHistory[Newer].Location;
+	}
+	for (int i = 1; i < HitboxHistoryNum; i++) {
+		int Older = (HitboxHistoryHead - 1 - i + HitboxHistorySize) % HitboxHistorySize;
+		if (HitboxHistory[Older].Time <= Time) {
+			const float Span = HitboxHistory[Newer].Time - HitboxHistory[Older].Time;
+			const float Alpha = Span > 0 ? (Time - HitboxHistory[Older].Time) / Span : 0;
+			return FMath::Lerp(HitboxHistory[Older].Location, HitboxHistory[Newer].Location, Alpha);
+		}
+		Newer = Older;
+	}
+	// older than the whole history, use the oldest sample
+	return HitboxHistory[Newer].Location;
+}
+
+int AFortniteCloneCharacter::GetBuildPieceIndex(const FString& Mode) const {
+	if (Mode == FString("Wall")) {
+		return 0;
+	}
+	if (Mode == FString("Ramp")) {
+		return 1;
+	}
+	if (Mode == FString("Floor")) {
+		return 2;
+	}
+	return -1;
+}
+
+uint64 AFortniteCloneCharacter::GetBuildSlot(int PieceIndex, FTransform& OutTransform) const {
+	// distance in front of the character for the wall, ramp and floor
+	const float ForwardOffsets[] = { 200, 100, 120 };
+	FVector DirectionVector = FVector(0, AimYaw, AimPitch);
+	FVector Location = GetActorLocation() + (GetActorForwardVector() * ForwardOffsets[PieceIndex]) + (DirectionVector * 3);
+	return FBuildGrid::SnapToSlot(PieceIndex, Location, GetActorRotation(), OutTransform);
+}
+
+void AFortniteCloneCharacter::UpdateBuildingPreviews() {
+	int PieceIndex = -1;
+	if (GetController()) {
+		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
+		if (State && State->InBuildMode) {
+			PieceIndex = GetBuildPieceIndex(State->BuildMode);
+		}
+	}
+	for (int i = 0; i < BuildingPreviews.Num(); i++) {
+		if (i != PieceIndex && BuildingPreviews[i] && !BuildingPreviews[i]->bHidden) {
+			BuildingPreviews[i]->SetActorHiddenInGame(true);
+		}
+	}
+	if (PieceIndex == -1 || CurrentBuildingMaterial < 0 || CurrentBuildingMaterial > 2) {
+		return;
+	}
+	ABuildingActor* Preview = GetBuildingPreview(PieceIndex, CurrentBuildingMaterial);
+	if (Preview) {
+		FTransform BuildTransform;
+		GetBuildSlot(PieceIndex, BuildTransform);
+		Preview->SetActorTransform(BuildTransform);
+		Preview->SetActorHiddenInGame(false);
+	}
+}
+
+ABuildingActor* AFortniteCloneCharacter::GetBuildingPreview(int PieceIndex, int Material) {
+	ABuildingActor* Preview = BuildingPreviews[PieceIndex];
+	if (Preview && BuildingPreviewMaterials[PieceIndex] == Material) {
+		return Preview;
+	}
+	if (Preview && PreviewMaterials.IsValidIndex(Material) && PreviewMaterials[Material] != nullptr) {
+		UStaticMeshComponent* PreviewStaticMeshComponent = Cast<UStaticMeshComponent>(Preview->GetComponentByClass(UStaticMeshComponent::StaticClass()));
+		if (PreviewStaticMeshComponent) {
+			for (int i = 0; i < PreviewStaticMeshComponent->GetNumMaterials(); i++) {
+				PreviewStaticMeshComponent->SetMaterial(i, PreviewMaterials[Material]);
+			}
+			BuildingPreviewMaterials[PieceIndex] = Material;
+			return Preview;
+		}
+	}
+	// no material to swap in, so this piece's preview is respawned once for the new material
+	if (Preview) {
+		Preview->Destroy();
+		BuildingPreviews[PieceIndex] = nullptr;
+		BuildingPreviewMaterials[PieceIndex] = -1;
+	}
+	const TArray<TSubclassOf<ABuildingActor>>& PreviewClasses = PieceIndex == 0 ? WallPreviewClasses : (PieceIndex == 1 ? RampPreviewClasses : FloorPreviewClasses);
+	if (!PreviewClasses.IsValidIndex(Material) || PreviewClasses[Material] == nullptr) {
+		return nullptr;
+	}
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Owner = this;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	FTransform BuildTransform;
+	GetBuildSlot(PieceIndex, BuildTransform);
+	Preview = GetWorld()->SpawnActor<ABuildingActor>(PreviewClasses[Material], BuildTransform, SpawnParameters);
+	if (Preview) {
+		// the preview only exists on this client and must not block or overlap anything
+		Preview->SetReplicates(false);
+		Preview->SetActorEnableCollision(false);
+		BuildingPreviews[PieceIndex] = Preview;
+		BuildingPreviewMaterials[PieceIndex] = Material;
+	}
+	return Preview;
+}
+
+void AFortniteCloneCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) {
+	Super::PreReplication(ChangedPropertyTracker);
+	// pack once per net update so the replication layer only compares a single word
+	AnimState.Pack(IsWalking, IsRunning, HoldingWeapon, AimedIn, HoldingWeaponType, WalkingX, WalkingY, AimPitch, AimYaw);
+}
+
+void AFortniteCloneCharacter::OnRep_AnimState() {
+	// the owning client predicts its own locomotion in the movement component
+	if (Role != ROLE_AutonomousProxy) {
+		IsWalking = AnimState.IsWalking();
+		IsRunning = AnimState.IsRunning();
+		WalkingX = AnimState.MoveX();
+		WalkingY = AnimState.MoveY();
+		RunningX = WalkingX;
+		RunningY = WalkingY;
+	}
+	HoldingWeapon = AnimState.HoldingWeapon();
+	AimedIn = AnimState.AimedIn();
+	HoldingWeaponType = AnimState.HoldingWeaponType();
+	ReplicatedAimPitch = AnimState.AimPitch();
+	ReplicatedAimYaw = AnimState.AimYaw();
+}
+
+void AFortniteCloneCharacter::OnRep_ActionEvent() {
+	UAnimMontage* Montage = GetActionMontage(ActionEvent.GetMontage());
+	if (Montage == nullptr) {
+		return;
+	}
+	AGameStateBase* GameState = GetWorld()->GetGameState();
+	float Elapsed = GameState ? GameState->GetServerWorldTimeSeconds() - ActionEvent.GetStartTime() : 0.0f;
+	if (Elapsed >= Montage->GetPlayLength()) {
+		return; // the character only just became relevant and the montage is already over
+	}
+	PlayAnimMontage(Montage, 1.f, NAME_None);
+	// anything later than normal latency means this client missed the start, so join the montage where it is now
+	if (Elapsed > 0.25f && GetMesh()->GetAnimInstance()) {
+		GetMesh()->GetAnimInstance()->Montage_SetPosition(Montage, Elapsed);
+	}
+}
+
+void AFortniteCloneCharacter::PlayActionMontage(ECharacterMontage Montage) {
+	AGameStateBase* GameState = GetWorld()->GetGameState();
+	ActionEvent.Start(Montage, GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds());
+	PlayAnimMontage(GetActionMontage(Montage), 1.f, NAME_None);
+}
+
+UAnimMontage* AFortniteCloneCharacter::GetActionMontage(ECharacterMontage Montage) const {
+	switch (Montage) {
+	case ECharacterMontage::PickaxeSwing:
+		return PickaxeSwingingAnimation;
+	case ECharacterMontage::ShootRifle:
+		return RifleHipShootingAnimation;
+	case ECharacterMontage::ShootShotgun:
+		return ShotgunHipShootingAnimation;
+	case ECharacterMontage::ShootRifleIronsights:
+		return RifleIronsightsShootingAnimation;
+	case ECharacterMontage::ShootShotgunIronsights:
+		return ShotgunIronsightsShootingAnimation;
+	case ECharacterMontage::UseBandage:
+		return HealingAnimation;
+	case ECharacterMontage::ReloadRifle:
+		return RifleHipReloadAnimation;
+	case ECharacterMontage::ReloadRifleIronsights:
+		return RifleIronsightsReloadAnimation;
+	case ECharacterMontage::ReloadShotgun:
+		return ShotgunHipReloadAnimation;
+	case ECharacterMontage::ReloadShotgunIronsights:
+		return ShotgunIronsightsReloadAnimation;
+	default:
+		return nullptr;
+	}
+}
+
+void AFortniteCloneCharacter::OnRep_ActiveEquipmentSlot() {
+	UpdateEquipmentVisibility();
+}
+
+void AFortniteCloneCharacter::UpdateEquipmentVisibility() {
+	// pooled items never get destroyed on a swap, the inactive ones are hidden with their collision off
+	for (int i = 0; i < WeaponPool.Num(); i++) {
+		if (WeaponPool[i]) {
+			WeaponPool[i]->SetActorHiddenInGame(ActiveEquipmentSlot != i);
+			WeaponPool[i]->SetActorEnableCollision(ActiveEquipmentSlot == i);
+		}
+	}
+	if (HealingItemPool) {
+		HealingItemPool->SetActorHiddenInGame(ActiveEquipmentSlot != -1);
+		HealingItemPool->SetActorEnableCollision(ActiveEquipmentSlot == -1);
+	}
+	UFortniteCloneReplicationGraph* ReplicationGraph = HasAuthority() ? UFortniteCloneReplicationGraph::Get(GetWorld()) : nullptr;
+	if (ReplicationGraph) {
+		ReplicationGraph->UpdateHeldEquipment(this);
+	}
+}
+
+void AFortniteCloneCharacter::EquipFromPool(int WeaponType, AFortniteClonePlayerState* State) {
+	StowEquipment(State);
+	FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
+	FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
+	if (WeaponPool.IsValidIndex(WeaponType)) {
+		if (WeaponPool[WeaponType] == nullptr && WeaponClasses.IsValidIndex(WeaponType)) {
+			FName WeaponSocketName = TEXT("hand_right_socket");
+			AWeaponActor* Weapon = Cast<AWeaponActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, WeaponClasses[WeaponType], SpawnTransform));
+			if (Weapon != nullptr)
+			{
+				//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
+				Weapon->Holder = this;
+				if (State && WeaponType > 0) {
+					Weapon->CurrentBulletCount = State->Inventory->GetCount(EInventoryItem::Clip, WeaponType);
+				}
+				UGameplayStatics::FinishSpawningActor(Weapon, SpawnTransform);
+				Weapon->SetNetDormancy(DORM_Awake);
+				UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(Weapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
+				WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
+			}
+			WeaponPool[WeaponType] = Weapon;
+		}
+		CurrentWeapon = WeaponPool[WeaponType];
+
+		//animinstance properties
+		HoldingWeapon = true;
+		AimedIn = false;
+		HoldingWeaponType = 1;
+		if (State) {
+			State->HoldingWeapon = true;
+			State->HoldingBandage = false;
+			State->CurrentWeapon = WeaponType;
+		}
+	}
+	else {
+		if (HealingItemPool == nullptr) {
+			FName BandageSocketName = TEXT("hand_left_socket");
+			AHealingActor* HealingItem = Cast<AHealingActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, BandageClass, SpawnTransform));
+			if (HealingItem != nullptr)
+			{
+				//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
+				HealingItem->Holder = this;
+				UGameplayStatics::FinishSpawningActor(HealingItem, SpawnTransform);
+				HealingItem->SetNetDormancy(DORM_Awake);
+				UStaticMeshComponent* HealingItemStaticMeshComponent = Cast<UStaticMeshComponent>(HealingItem->GetComponentByClass(UStaticMeshComponent::StaticClass()));
+				HealingItemStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, BandageSocketName);
+			}
+			HealingItemPool = HealingItem;
+		}
+		CurrentHealingItem = HealingItemPool;
+		WeaponType = -1;
+
+		//animinstance properties
+		HoldingWeapon = false;
+		AimedIn = false;
+		HoldingWeaponType = 0;
+		if (State) {
+			State->HoldingWeapon = false;
+			State->HoldingBandage = true;
+			State->CurrentWeapon = -1;
+		}
+	}
+	CurrentWeaponType = WeaponType;
+	ActiveEquipmentSlot = WeaponType;
+	UpdateEquipmentVisibility();
+}
+
+void AFortniteCloneCharacter::StowEquipment(AFortniteClonePlayerState* State) {
+	if (State && CurrentWeapon && CurrentWeaponType > 0 && WeaponPool.IsValidIndex(CurrentWeaponType)) {
+		State->Inventory->SetCount(EInventoryItem::Clip, CurrentWeaponType, CurrentWeapon->CurrentBulletCount);
+	}
+	if (State && CurrentHealingItem) {
+		// putting the bandage away interrupts it, the heal is lost
+		State->CancelAction(EPlayerAction::UseBandage);
+		BandageHealPending = false;
 	}
+	CurrentWeapon = nullptr;
+	CurrentHealingItem = nullptr;
+	ActiveEquipmentSlot = -2;
+	UpdateEquipmentVisibility();
 }
 
 void AFortniteCloneCharacter::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) {
-	if (HasAuthority()) {
+	SCOPE_CYCLE_COUNTER(STAT_CharacterOverlap);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::CharacterOverlap);
+	if (HasAuthority() && IsAlive()) {
 		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("NetMode: ") + FString::FromInt(GetNetMode()) + FString(" Player overlapped with: ") + OtherActor->GetName());
 		if (OtherActor != nullptr && OtherActor != this) {
 			if (CurrentWeapon != nullptr && OtherActor == (AActor*)CurrentWeapon) {
@@ -360,46 +685,35 @@ void AFortniteCloneCharacter::OnOverlapBegin(UPrimitiveComponent* OverlappedComp
 					// pick up the item if the two conditions above are false
 					AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 					if (State) {
-						if (State->InBuildMode || State->JustShotRifle || State->JustShotShotgun || State->JustSwungPickaxe || State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun) {
+						if (State->InBuildMode || State->IsAnyActionActive()) {
 							return; // can't pick up items while in build mode or if just shot rifle, shot shotgun, swung pickaxe, used bandage, or reloaded
 						}
 						// if the player already has a weapon of this type, do not equip it
-						if (State->EquippedWeapons.Contains(WeaponActor->WeaponType)) {
+						if (State->Inventory->HasWeapon(WeaponActor->WeaponType)) {
 							return;
 						}
-						// Destroy old weapon/healing item
-						if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-							State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-						}
-						if (CurrentWeapon) {
-							CurrentWeapon->Destroy();
-							CurrentWeapon = nullptr;
+						if (!WeaponPool.IsValidIndex(WeaponActor->WeaponType)) {
+							return; // no definition for this weapon type
 						}
-						if (CurrentHealingItem) {
-							CurrentHealingItem->Destroy();
-							CurrentHealingItem = nullptr;
-						}
-						// PICK UP WEAPON
+						// PICK UP WEAPON, the picked up actor becomes the pooled instance for its type
 						FName WeaponSocketName = TEXT("hand_right_socket");
 						FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
 
-						CurrentWeapon = WeaponActor;
-						CurrentWeaponType = WeaponActor->WeaponType;
-						CurrentWeapon->Holder = this;
-						int MagazineSize = CurrentWeapon->MagazineSize;
-						CurrentWeapon->CurrentBulletCount = MagazineSize;
+						// held items replicate their attachment and visibility so they can't stay dormant
+						WeaponActor->Holder = this;
+						WeaponActor->SetNetDormancy(DORM_Awake);
+						const UWeaponDefinition* Definition = UFortniteCloneAssetManager::GetWeaponDefinition(WeaponActor->WeaponType);
+						int MagazineSize = Definition ? Definition->GetMagazineSize(WeaponActor) : WeaponActor->MagazineSize;
+						WeaponActor->CurrentBulletCount = MagazineSize;
 
 						UStaticMeshComponent* OutHitStaticMeshComponent = Cast<UStaticMeshComponent>(WeaponActor->GetComponentByClass(UStaticMeshComponent::StaticClass()));
 						OutHitStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
 
-						State->HoldingWeapon = true;
-						State->HoldingBandage = false;
-						State->EquippedWeapons.Add(WeaponActor->WeaponType);
-						State->CurrentWeapon = WeaponActor->WeaponType;
-						State->EquippedWeaponsClips[CurrentWeaponType] = MagazineSize;
-
-						HoldingWeapon = true;
-						HoldingWeaponType = 1;
+						WeaponPool[WeaponActor->WeaponType] = WeaponActor;
+						State->Inventory->SetCount(EInventoryItem::Weapon, WeaponActor->WeaponType, 1);
+						State->Inventory->SetCount(EInventoryItem::Clip, WeaponActor->WeaponType, MagazineSize);
+						FMatchEventLog::Get().Record(EMatchEvent::Pickup, (uint8)EInventoryItem::Weapon, (uint8)WeaponActor->WeaponType, State->PlayerId, -1, 1, GetActorLocation());
+						EquipFromPool(WeaponActor->WeaponType, State);
 					}
 
 				}
@@ -408,45 +722,35 @@ void AFortniteCloneCharacter::OnOverlapBegin(UPrimitiveComponent* OverlappedComp
 			else if (OtherActor->IsA(AHealingActor::StaticClass())) {
 				//pick up the item
 				AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-				if (CurrentHealingItem) {
-					CurrentHealingItem->Destroy();
-					CurrentHealingItem = nullptr;
-				}
 				if (State) {
 					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, OtherActor->GetName());
-					if (State->InBuildMode || State->JustShotRifle || State->JustShotShotgun || State->JustSwungPickaxe || State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun) {
+					if (State->InBuildMode || State->IsAnyActionActive()) {
 						return; // can't pick up items while in build mode or if just shot rifle, shot shotgun, swung pickaxe, used bandage, or reloaded
 					}
-					CurrentHealingItem = Cast<AHealingActor>(OtherActor);
-					if (CurrentHealingItem->Holder != nullptr) {
+					AHealingActor* HealingActor = Cast<AHealingActor>(OtherActor);
+					if (HealingActor->Holder != nullptr) {
 						return; // do nothing if someone is holding the weapon
 					}
 					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("didn't end early"));
-					// Destroy old weapon
-					if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-						State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-					}
-					if (CurrentWeapon) {
-						CurrentWeapon->Destroy();
-						CurrentWeapon = nullptr;
-					}
 					// PICK UP BANDAGE 
-					FName BandageSocketName = TEXT("hand_left_socket");
-					FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-					CurrentWeapon = nullptr;
-					CurrentWeaponType = -1;
-					CurrentHealingItem->Holder = this;
-					UStaticMeshComponent* OutHitStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentHealingItem->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-					OutHitStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, BandageSocketName);
-
-
-					State->HoldingWeapon = false;
-					State->HoldingBandage = true;
-					State->BandageCount += 3;
-					State->CurrentWeapon = -1;
+					if (HealingItemPool == nullptr) {
+						// the first bandage picked up becomes the pooled instance
+						FName BandageSocketName = TEXT("hand_left_socket");
+						FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
 
-					HoldingWeapon = false;
+						HealingActor->Holder = this;
+						HealingActor->SetNetDormancy(DORM_Awake);
+						UStaticMeshComponent* OutHitStaticMeshComponent = Cast<UStaticMeshComponent>(HealingActor->GetComponentByClass(UStaticMeshComponent::StaticClass()));
+						OutHitStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, BandageSocketName);
+						HealingItemPool = HealingActor;
+					}
+					else {
+						// already carrying a bandage, the picked up one only adds to the count
+						HealingActor->Destroy();
+					}
+					State->Inventory->AddCount(EInventoryItem::Bandage, 0, 3);
+					FMatchEventLog::Get().Record(EMatchEvent::Pickup, (uint8)EInventoryItem::Bandage, 0, State->PlayerId, -1, 3, GetActorLocation());
+					EquipFromPool(-1, State);
 				}
 			}
 			else if (OtherActor->IsA(AAmmunitionActor::StaticClass())) {
@@ -455,38 +759,17 @@ void AFortniteCloneCharacter::OnOverlapBegin(UPrimitiveComponent* OverlappedComp
 					AAmmunitionActor* Ammo = Cast<AAmmunitionActor>(OtherActor);
 					if (State) {
 						// increment ammo count
-						State->EquippedWeaponsAmmunition[Ammo->WeaponType] += Ammo->BulletCount;
+						State->Inventory->AddCount(EInventoryItem::Ammunition, Ammo->WeaponType, Ammo->BulletCount);
+						FMatchEventLog::Get().Record(EMatchEvent::Pickup, (uint8)EInventoryItem::Ammunition, (uint8)Ammo->WeaponType, State->PlayerId, -1, Ammo->BulletCount, GetActorLocation());
 					}
 					Ammo->Destroy();
 				}
 			}
-			else if (OtherActor->IsA(AStormActor::StaticClass())) {
-				FString LogMsg = FString("storm overlap begin ") + FString::FromInt(GetNetMode());
-				//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, LogMsg);
-				UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-				InStorm = false;
-			}
 			//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, OtherActor->GetName());
 		}
 	}
 }
 
-void AFortniteCloneCharacter::OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex) {
-	if (HasAuthority()) {
-		FString LogMsg = FString("storm overlap end ") + FString::FromInt(GetNetMode());
-		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, LogMsg);
-		UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-		if (OtherActor != nullptr) {
-			if (OtherActor == this) {
-				return;
-			}
-			if (OtherActor->IsA(AStormActor::StaticClass())) {
-				InStorm = true;
-			}
-		}
-	}
-}
-
 float AFortniteCloneCharacter::PlayAnimMontage(class UAnimMontage* AnimMontage, float InPlayRate, FName StartSectionName)
 {
 	USkeletalMeshComponent* UseMesh = GetMesh();
@@ -529,11 +812,11 @@ void AFortniteCloneCharacter::MoveForward(float Value)
 {
 	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("move forward ") + FString::FromInt(GetNetMode()));
 	
-	if ((Controller != nullptr) && (Value != 0.0f))
+	if ((Controller != nullptr) && (Value != 0.0f) && IsAlive())
 	{
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(Controller->PlayerState);
 		if (State) {
-			if (State->JustUsedBandage) {
+			if (State->IsActionActive(EPlayerAction::UseBandage)) {
 				return;
 			}
 			// find out which way is forward
@@ -545,40 +828,25 @@ void AFortniteCloneCharacter::MoveForward(float Value)
 			if (AimedIn) {
 				AddMovementInput(Direction, Value * 0.2);
 			}
-			else if (IsRunning) {
+			else if (GetFortniteCloneMovement()->bWantsToRun) {
 				AddMovementInput(Direction, Value * 0.9);
 			}
-			else if (IsWalking) {
+			else if (GetFortniteCloneMovement()->bWantsToWalk) {
 				AddMovementInput(Direction, Value * 0.45);
 			}
 		}
 	}
-	/*UThirdPersonAnimInstance* Animation = Cast<UThirdPersonAnimInstance>(GetMesh()->GetAnimInstance());
-	if (Animation) {
-		//set blend space variable
-		Animation->WalkingY = Value * 90;
-		Animation->RunningY = Value * 90;
-		//Server_SetMovingVariables();
-	}*/
-	if (Value == 0) {
-		ServerResetMovingForward();
-	}
-	else if (Value > 0) {
-		ServerSetMovingForwards();
-	}
-	else {
-		ServerSetMovingBackwards();
-	}
+	// the blend space direction is derived from the move acceleration by the movement component
 }
 
 void AFortniteCloneCharacter::MoveRight(float Value)
 {
 
-	if ((Controller != nullptr) && (Value != 0.0f))
+	if ((Controller != nullptr) && (Value != 0.0f) && IsAlive())
 	{
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(Controller->PlayerState);
 		if (State) {
-			if (State->JustUsedBandage) {
+			if (State->IsActionActive(EPlayerAction::UseBandage)) {
 				return;
 			}
 		}
@@ -592,33 +860,20 @@ void AFortniteCloneCharacter::MoveRight(float Value)
 		if (AimedIn) {
 			AddMovementInput(Direction, Value * 0.2);
 		}
-		else if (IsRunning) {
+		else if (GetFortniteCloneMovement()->bWantsToRun) {
 			AddMovementInput(Direction, Value * 0.9);
 		}
-		else if (IsWalking) {
+		else if (GetFortniteCloneMovement()->bWantsToWalk) {
 			AddMovementInput(Direction, Value * 0.45);
 		}
 	}
-	/*UThirdPersonAnimInstance* Animation = Cast<UThirdPersonAnimInstance>(GetMesh()->GetAnimInstance());
-	if (Animation) {
-		//set blend space variable
-		Animation->WalkingX = Value * 90;
-		Animation->RunningX = Value * 90;
-		//Server_SetMovingVariables();
-	}*/
-	if (Value == 0) {
-		ServerResetMovingRight();
-	}
-	else if (Value > 0) {
-		ServerSetMovingRight();
-	}
-	else {
-		ServerSetMovingLeft();
-	}
 }
 
 void AFortniteCloneCharacter::Sprint(float Value) {
 	APlayerController* LocalController = Cast<APlayerController>(GetController());
+	if (LocalController == nullptr) {
+		return;
+	}
 	bool ADown = LocalController->IsInputKeyDown(EKeys::A);
 	bool WDown = LocalController->IsInputKeyDown(EKeys::W);
 	bool SDown = LocalController->IsInputKeyDown(EKeys::S);
@@ -630,32 +885,27 @@ void AFortniteCloneCharacter::Sprint(float Value) {
 			//ServerSetAimedInSpeed();
 		}
 		else if (Value == 0) {
-			//ServerSetWalkingSpeed();
-			ServerSetIsRunningFalse();
+			GetFortniteCloneMovement()->bWantsToRun = false;
 		}
 		else {
 			// can only sprint if the w key is held down by itself or in combination with the a or d keys
-			if (!(OnlyAOrDDown || SDown) && WDown) {
-				//ServerSetRunningSpeed();
-				ServerSetIsRunningTrue();
-			}
-			else {
-				//ServerSetWalkingSpeed();
-				ServerSetIsRunningFalse();
-			}
+			GetFortniteCloneMovement()->bWantsToRun = !(OnlyAOrDDown || SDown) && WDown;
 		}
 	}
-	//Server_SetAnimationVariables();
+	// the flag is sent to the server in the compressed flags of the next saved move
 }
 
 void AFortniteCloneCharacter::StartWalking() {
-	ServerSetIsWalkingTrue();
+	GetFortniteCloneMovement()->bWantsToWalk = true;
 }
 
 
 void AFortniteCloneCharacter::StopWalking() {
 	//UThirdPersonAnimInstance* Animation = Cast<UThirdPersonAnimInstance>(GetMesh()->GetAnimInstance());
 	APlayerController* LocalController = Cast<APlayerController>(GetController());
+	if (LocalController == nullptr) {
+		return;
+	}
 	bool ADown = LocalController->IsInputKeyDown(EKeys::A);
 	bool WDown = LocalController->IsInputKeyDown(EKeys::W);
 	bool SDown = LocalController->IsInputKeyDown(EKeys::S);
@@ -663,9 +913,8 @@ void AFortniteCloneCharacter::StopWalking() {
 	bool NoWalkingKeysDown = !ADown && !WDown && !SDown && !DDown;
 
 	if (NoWalkingKeysDown) {
-		ServerSetIsWalkingFalse();
+		GetFortniteCloneMovement()->bWantsToWalk = false;
 	}
-	//ServerSetAnimationVariables();
 }
 
 TArray<float> AFortniteCloneCharacter::CalculateWalkingXY() {
@@ -733,67 +982,70 @@ void AFortniteCloneCharacter::AimGunOut() {
 	ServerAimHipFire();
 }
 
-void AFortniteCloneCharacter::PickaxeTimeOut() {
-	ServerPickaxeTimeOut();
+void AFortniteCloneCharacter::HoldPickaxe() {
+	ServerSwitchToWeapon(0);
 }
 
-void AFortniteCloneCharacter::RifleTimeOut() {
-	ServerRifleTimeOut();
+void AFortniteCloneCharacter::HoldAssaultRifle() {
+	ServerSwitchToWeapon(1);
 }
 
-void AFortniteCloneCharacter::ShotgunTimeOut() {
-	ServerShotgunTimeOut();
+void AFortniteCloneCharacter::HoldShotgun() {
+	ServerSwitchToWeapon(2);
 }
 
-void AFortniteCloneCharacter::RifleReloadTimeOut() {
-	AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-	State->JustReloadedRifle= false;
+void AFortniteCloneCharacter::HoldBandage() {
+	ServerSwitchToBandage();
 }
 
-void AFortniteCloneCharacter::ShotgunReloadTimeOut() {
-	AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-	State->JustReloadedShotgun = false;
+UFortniteCloneCharacterMovement* AFortniteCloneCharacter::GetFortniteCloneMovement() const {
+	return Cast<UFortniteCloneCharacterMovement>(GetCharacterMovement());
 }
 
+void AFortniteCloneCharacter::SetLocomotionState(bool bWalking, bool bRunning, int8 MoveX, int8 MoveY) {
+	IsWalking = bWalking;
+	IsRunning = bRunning;
+	WalkingX = MoveX;
+	RunningX = MoveX;
+	WalkingY = MoveY;
+	RunningY = MoveY;
+}
 
-void AFortniteCloneCharacter::BandageTimeOut() {
-	if (Health < 100) {
-		if (Health + 15 > 100) {
-			Health = 100;
+void AFortniteCloneCharacter::OnRep_Health() {
+	APlayerController* PlayerController = Cast<APlayerController>(GetController());
+	UHUDViewModel* ViewModel = UHUDViewModel::Get(PlayerController);
+	if (ViewModel) {
+		ViewModel->SetHealth(Health);
+	}
+	if (!IsAlive()) {
+		// the death can wait in the game mode's queue for a few frames, nothing the character does in that time should count
+		GetCharacterMovement()->StopMovementImmediately();
+		GetCharacterMovement()->DisableMovement();
+		if (PlayerController) {
+			DisableInput(PlayerController);
 		}
-		else {
-			Health += 15;
+		// nothing started before the death finishes after it
+		BandageHealPending = false;
+		AFortniteClonePlayerState* State = GetController() ? Cast<AFortniteClonePlayerState>(GetController()->PlayerState) : nullptr;
+		if (State) {
+			State->CancelAllActions();
 		}
 	}
-	AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-	State->JustUsedBandage = false;
-}
-
-void AFortniteCloneCharacter::HoldPickaxe() {
-	ServerSwitchToPickaxe();
-}
-
-void AFortniteCloneCharacter::HoldAssaultRifle() {
-	ServerSwitchToRifle();
-}
-
-void AFortniteCloneCharacter::HoldShotgun() {
-	ServerSwitchToShotgun();
-}
-
-void AFortniteCloneCharacter::HoldBandage() {
-	ServerSwitchToBandage();
 }
 
 float AFortniteCloneCharacter::GetHealth() {
 	return Health;
 }
 
+bool AFortniteCloneCharacter::IsAlive() const {
+	return Health > 0;
+}
+
 int AFortniteCloneCharacter::GetWoodMaterialCount() {
 	if (GetController()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			return State->MaterialCounts[0];
+			return State->Inventory->GetCount(EInventoryItem::Material, 0);
 		}
 		else {
 			return 0;
@@ -808,7 +1060,7 @@ int AFortniteCloneCharacter::GetStoneMaterialCount() {
 	if (GetController()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			return State->MaterialCounts[1];
+			return State->Inventory->GetCount(EInventoryItem::Material, 1);
 		}
 		else {
 			return 0;
@@ -823,7 +1075,7 @@ int AFortniteCloneCharacter::GetSteelMaterialCount() {
 	if (GetController()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			return State->MaterialCounts[2];
+			return State->Inventory->GetCount(EInventoryItem::Material, 2);
 		}
 		else {
 			return 0;
@@ -838,7 +1090,7 @@ int AFortniteCloneCharacter::GetAssaultRifleAmmoCount() {
 	if (GetController()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			return State->EquippedWeaponsAmmunition[1] + State->EquippedWeaponsClips[1];
+			return State->Inventory->GetCount(EInventoryItem::Ammunition, 1) + State->Inventory->GetCount(EInventoryItem::Clip, 1);
 		}
 		else {
 			return 0;
@@ -853,7 +1105,7 @@ int AFortniteCloneCharacter::GetShotgunAmmoCount() {
 	if (GetController()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			return State->EquippedWeaponsAmmunition[2] + State->EquippedWeaponsClips[2];
+			return State->Inventory->GetCount(EInventoryItem::Ammunition, 2) + State->Inventory->GetCount(EInventoryItem::Clip, 2);
 		}
 		else {
 			return 0;
@@ -868,7 +1120,7 @@ int AFortniteCloneCharacter::GetBandageCount() {
 	if (GetController()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			return State->BandageCount;
+			return State->Inventory->GetCount(EInventoryItem::Bandage, 0);
 		}
 		else {
 			return 0;
@@ -879,38 +1131,6 @@ int AFortniteCloneCharacter::GetBandageCount() {
 	}
 }
 
-void AFortniteCloneCharacter::ServerSetIsWalkingTrue_Implementation() {
-	IsWalking = true;
-}
-
-bool AFortniteCloneCharacter::ServerSetIsWalkingTrue_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerSetIsWalkingFalse_Implementation() {
-	IsWalking = false;
-}
-
-bool AFortniteCloneCharacter::ServerSetIsWalkingFalse_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerSetIsRunningTrue_Implementation() {
-	IsRunning = true;
-}
-
-bool AFortniteCloneCharacter::ServerSetIsRunningTrue_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerSetIsRunningFalse_Implementation() {
-	IsRunning = false;
-}
-
-bool AFortniteCloneCharacter::ServerSetIsRunningFalse_Validate() {
-	return true;
-}
-
 void AFortniteCloneCharacter::ServerSetWalkingSpeed_Implementation() {
 	GetCharacterMovement()->MaxWalkSpeed = 450.0;
 	ClientSetWalkingSpeed();
@@ -950,247 +1170,85 @@ void AFortniteCloneCharacter::ClientSetAimedInSpeed_Implementation() {
 	GetCharacterMovement()->MaxWalkSpeed = 200.0;
 }
 
-void AFortniteCloneCharacter::ServerSetMovingForwards_Implementation() {
-	WalkingY = 90;
-	RunningY = 90;
-}
-
-bool AFortniteCloneCharacter::ServerSetMovingForwards_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerSetMovingBackwards_Implementation() {
-	WalkingY = -90;
-	RunningY = -90;
-}
-
-bool AFortniteCloneCharacter::ServerSetMovingBackwards_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerSetMovingLeft_Implementation() {
-	WalkingX = -90;
-	RunningX = -90;
+void AFortniteCloneCharacter::ServerSetBuildModeWall_Implementation() {
+	ToggleBuildMode(FString("Wall"));
 }
 
-bool AFortniteCloneCharacter::ServerSetMovingLeft_Validate() {
+bool AFortniteCloneCharacter::ServerSetBuildModeWall_Validate() {
 	return true;
 }
 
-void AFortniteCloneCharacter::ServerSetMovingRight_Implementation() {
-	WalkingX = 90;
-	RunningX = 90;
+void AFortniteCloneCharacter::ServerSetBuildModeRamp_Implementation() {
+	ToggleBuildMode(FString("Ramp"));
 }
 
-bool AFortniteCloneCharacter::ServerSetMovingRight_Validate() {
+bool AFortniteCloneCharacter::ServerSetBuildModeRamp_Validate() {
 	return true;
 }
 
-void AFortniteCloneCharacter::ServerResetMovingForward_Implementation() {
-	WalkingY = 0;
-	RunningY = 0;
+void AFortniteCloneCharacter::ServerSetBuildModeFloor_Implementation() {
+	if (GetController()) {
+		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
+		if (State && State->IsActionActive(EPlayerAction::SwingPickaxe)) {
+			return; //currently swinging pickaxe
+		}
+	}
+	ToggleBuildMode(FString("Floor"));
 }
 
-bool AFortniteCloneCharacter::ServerResetMovingForward_Validate() {
+bool AFortniteCloneCharacter::ServerSetBuildModeFloor_Validate() {
 	return true;
 }
 
-void AFortniteCloneCharacter::ServerResetMovingRight_Implementation() {
-	WalkingX = 0;
-	RunningX = 0;
+bool AFortniteCloneCharacter::IsReloading(const AFortniteClonePlayerState* State) const {
+	const int WeaponCount = UFortniteCloneAssetManager::Get().GetWeaponCount();
+	for (int i = 0; i < WeaponCount; i++) {
+		const UWeaponDefinition* Definition = UFortniteCloneAssetManager::GetWeaponDefinition(i);
+		if (Definition && Definition->UsesAmmunition && State->IsActionActive(Definition->ReloadAction)) {
+			return true;
+		}
+	}
+	return false;
 }
 
-bool AFortniteCloneCharacter::ServerResetMovingRight_Validate() {
-	return true;
+bool AFortniteCloneCharacter::IsFiringOtherWeapon(const AFortniteClonePlayerState* State, int WeaponId) const {
+	// weapons can share a fire action, a shared action still belongs to the weapon being switched to
+	const UWeaponDefinition* Exception = UFortniteCloneAssetManager::GetWeaponDefinition(WeaponId);
+	const int WeaponCount = UFortniteCloneAssetManager::Get().GetWeaponCount();
+	for (int i = 0; i < WeaponCount; i++) {
+		const UWeaponDefinition* Definition = UFortniteCloneAssetManager::GetWeaponDefinition(i);
+		if (Definition && (Exception == nullptr || Definition->FireAction != Exception->FireAction) && State->IsActionActive(Definition->FireAction)) {
+			return true;
+		}
+	}
+	return false;
 }
 
-void AFortniteCloneCharacter::ServerSetBuildModeWall_Implementation() {
-	if (GetController()) {
+void AFortniteCloneCharacter::ToggleBuildMode(const FString& Mode) {
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			if (State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun) {
+			if (State->IsActionActive(EPlayerAction::UseBandage) || IsReloading(State)) {
 				return; //currently healing or reloading
 			}
 			if (State->HoldingWeapon && State->AimedIn) {
 				return; // currently aimed down sight
 			}
-			if (State->BuildMode == FString("Wall")) {
+			if (State->BuildMode == Mode) {
 				// getting out of build mode
 				State->InBuildMode = false;
 				State->BuildMode = FString("None");
-				if (BuildingPreview) {
-					BuildingPreview->Destroy(); //destroy the last wall preview
-				}
-				// equip weapon being held before
-				if (CurrentWeaponType > -1 && CurrentWeaponType < 3) {
-					FName WeaponSocketName = TEXT("hand_right_socket");
-					FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-					FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-					CurrentWeapon = Cast<AWeaponActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, WeaponClasses[CurrentWeaponType], SpawnTransform));
-					if (CurrentWeapon != nullptr)
-					{
-						//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-						CurrentWeapon->Holder = this;
-						if (CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-							CurrentWeapon->CurrentBulletCount = State->EquippedWeaponsClips[CurrentWeaponType];
-						}
-						UGameplayStatics::FinishSpawningActor(CurrentWeapon, SpawnTransform);
-					}
-
-					UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentWeapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-					WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
-
-					//animinstance properties
-					HoldingWeapon = true;
-					AimedIn = false;
-					HoldingWeaponType = 1;
-					State->HoldingWeapon = true;
-					State->HoldingBandage = false;
-					State->CurrentWeapon = CurrentWeaponType;
-
-				}
-				else {
-					//equip bandage since current weapon was null
-					FName BandageSocketName = TEXT("hand_left_socket");
-					FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-					FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-					auto CurrentHealingItem = Cast<AHealingActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, BandageClass, SpawnTransform));
-					if (CurrentHealingItem != nullptr)
-					{
-						//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-						CurrentHealingItem->Holder = this;
-
-						UGameplayStatics::FinishSpawningActor(CurrentHealingItem, SpawnTransform);
-					}
-
-					UStaticMeshComponent* HealingItemStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentHealingItem->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-					HealingItemStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, BandageSocketName);
-
-					//animinstance properties
-					HoldingWeapon = false;
-					AimedIn = false;
-					HoldingWeaponType = 0;
-					State->HoldingWeapon = false;
-					State->HoldingBandage = true;
-					
-				}
-			}
-			else if (State->InBuildMode) {
-				// switching to a different build mode
-				State->BuildMode = FString("Wall");
-			}
-			else {
-				// getting into build mode
-				State->InBuildMode = true;
-				State->BuildMode = FString("Wall");
-				State->HoldingWeapon = false;
-				State->HoldingBandage = false;
-				State->AimedIn = false; 
-				//animinstance properties
-				HoldingWeapon = false;
-				AimedIn = false;
-				HoldingWeaponType = 0;
-
-				// unequip weapon/healing item
-				if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-					State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-				}
-				if (CurrentWeapon) {
-					CurrentWeapon->Destroy();
-					CurrentWeapon = nullptr;
-				}
-				if (CurrentHealingItem) {
-					CurrentHealingItem->Destroy();
-					CurrentHealingItem = nullptr;
-				}
-			}
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerSetBuildModeWall_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerSetBuildModeRamp_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			if (State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun) {
-				return; //currently healing or reloading
-			}
-			if (State->HoldingWeapon && State->AimedIn) {
-				return; // currently aimed down sight
-			}
-			if (State->BuildMode == FString("Ramp")) {
-				// getting out of build mode
-				State->InBuildMode = false;
-				State->BuildMode = FString("None");
-				if (BuildingPreview) {
-					BuildingPreview->Destroy(); //destroy the last wall preview
-				}
-				// equip weapon being held before
-				if (CurrentWeaponType > -1 && CurrentWeaponType < 3) {
-					FName WeaponSocketName = TEXT("hand_right_socket");
-					FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-					FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-					CurrentWeapon = Cast<AWeaponActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, WeaponClasses[CurrentWeaponType], SpawnTransform));
-					if (CurrentWeapon != nullptr)
-					{
-						//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-						CurrentWeapon->Holder = this;
-						if (CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-							CurrentWeapon->CurrentBulletCount = State->EquippedWeaponsClips[CurrentWeaponType];
-						}
-						UGameplayStatics::FinishSpawningActor(CurrentWeapon, SpawnTransform);
-					}
-
-					UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentWeapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-					WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
-					//animinstance properties
-					HoldingWeapon = true;
-					AimedIn = false;
-					HoldingWeaponType = 1;
-					State->HoldingWeapon = true;
-					State->HoldingBandage = false;
-					State->CurrentWeapon = CurrentWeaponType;
-				}
-				else {
-					//equip bandage since current weapon was null
-					FName BandageSocketName = TEXT("hand_left_socket");
-					FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-					FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-					auto CurrentHealingItem = Cast<AHealingActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, BandageClass, SpawnTransform));
-					if (CurrentHealingItem != nullptr)
-					{
-						//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-						CurrentHealingItem->Holder = this;
-
-						UGameplayStatics::FinishSpawningActor(CurrentHealingItem, SpawnTransform);
-					}
-
-					UStaticMeshComponent* HealingItemStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentHealingItem->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-					HealingItemStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, BandageSocketName);
-					//animinstance properties
-					HoldingWeapon = false;
-					AimedIn = false;
-					HoldingWeaponType = 0;
-					State->HoldingWeapon = false;
-					State->HoldingBandage = true;
-				}
+				// equip weapon or bandage being held before
+				EquipFromPool(CurrentWeaponType, State);
 			}
 			else if (State->InBuildMode) {
 				// switching to a different build mode
-				State->BuildMode = FString("Ramp");
+				State->BuildMode = Mode;
 			}
 			else {
 				// getting into build mode
 				State->InBuildMode = true;
-				State->BuildMode = FString("Ramp");
+				State->BuildMode = Mode;
 				State->HoldingWeapon = false;
 				State->HoldingBandage = false;
 				State->AimedIn = false;
@@ -1198,184 +1256,46 @@ void AFortniteCloneCharacter::ServerSetBuildModeRamp_Implementation() {
 				HoldingWeapon = false;
 				AimedIn = false;
 				HoldingWeaponType = 0;
-				// unequip weapon/healing item
-				if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-					State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-				}
-				if (CurrentWeapon) {
-					CurrentWeapon->Destroy();
-					CurrentWeapon = nullptr;
-				}
-				if (CurrentHealingItem) {
-					CurrentHealingItem->Destroy();
-					CurrentHealingItem = nullptr;
-				}
-			}
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerSetBuildModeRamp_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerSetBuildModeFloor_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			if (State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun || State->JustSwungPickaxe) {
-				return; //currently healing or reloading or swinging pickaxe
-			}
-			if (State->HoldingWeapon && State->AimedIn) {
-				return; // currently aimed down sight
-			}
-			if (State->BuildMode == FString("Floor")) {
-				// getting out of build mode
-				State->InBuildMode = false;
-				State->BuildMode = FString("None");
-				if (BuildingPreview) {
-					BuildingPreview->Destroy(); //destroy the last wall preview
-				}
-				// equip weapon being held before
-				if (CurrentWeaponType > -1 && CurrentWeaponType < 3) {
-					FName WeaponSocketName = TEXT("hand_right_socket");
-					FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-					FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-					CurrentWeapon = Cast<AWeaponActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, WeaponClasses[CurrentWeaponType], SpawnTransform));
-					if (CurrentWeapon != nullptr)
-					{
-						//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-						CurrentWeapon->Holder = this;
-						if (CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-							CurrentWeapon->CurrentBulletCount = State->EquippedWeaponsClips[CurrentWeaponType];
-						}
-						UGameplayStatics::FinishSpawningActor(CurrentWeapon, SpawnTransform);
-					}
 
-					UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentWeapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-					WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
-
-					//animinstance properties
-					HoldingWeapon = true;
-					AimedIn = false;
-					HoldingWeaponType = 1;
-					State->HoldingWeapon = true;
-					State->HoldingBandage = false;
-					State->CurrentWeapon = CurrentWeaponType;
-				}
-				else {
-					//equip bandage since current weapon was null
-					FName BandageSocketName = TEXT("hand_left_socket");
-					FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-					FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-					auto CurrentHealingItem = Cast<AHealingActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, BandageClass, SpawnTransform));
-					if (CurrentHealingItem != nullptr)
-					{
-						//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-						CurrentHealingItem->Holder = this;
-
-						UGameplayStatics::FinishSpawningActor(CurrentHealingItem, SpawnTransform);
-					}
-
-					UStaticMeshComponent* HealingItemStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentHealingItem->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-					HealingItemStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, BandageSocketName);
-					//animinstance properties
-					HoldingWeapon = false;
-					AimedIn = false;
-					HoldingWeaponType = 0;
-					State->HoldingWeapon = false;
-					State->HoldingBandage = true;
-				}
-			}
-			else if (State->InBuildMode) {
-				// switching to a different build mode
-				State->BuildMode = FString("Floor");
-			}
-			else {
-				// getting into build mode
-				State->InBuildMode = true;
-				State->BuildMode = FString("Floor");
-				State->HoldingWeapon = false;
-				State->HoldingBandage = false;
-				State->AimedIn = false;
-				//animinstance properties
-				HoldingWeapon = false;
-				AimedIn = false;
-				HoldingWeaponType = 0;
 				// unequip weapon/healing item
-				if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-					State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-				}
-				if (CurrentWeapon) {
-					CurrentWeapon->Destroy();
-					CurrentWeapon = nullptr;
-				}
-				if (CurrentHealingItem) {
-					CurrentHealingItem->Destroy();
-					CurrentHealingItem = nullptr;
-				}
+				StowEquipment(State);
 			}
 		}
 	}
 }
 
-bool AFortniteCloneCharacter::ServerSetBuildModeFloor_Validate() {
-	return true;
-}
-
 void AFortniteCloneCharacter::ServerBuildStructures_Implementation() {
-	if (GetController()) {
+	SCOPE_CYCLE_COUNTER(STAT_BuildStructures);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::BuildStructures);
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			FVector DirectionVector = FVector(0, AimYaw, AimPitch);
-			if (State->InBuildMode && State->BuildMode == FString("Wall") && State->MaterialCounts[CurrentBuildingMaterial] >= 10) {
-				TArray<AActor*> OverlappingActors;
-				ABuildingActor* Wall = GetWorld()->SpawnActor<ABuildingActor>(WallClasses[CurrentBuildingMaterial], GetActorLocation() + (GetActorForwardVector() * 200) + (DirectionVector * 3), GetActorRotation().Add(0, 90, 0));
-
-				Wall->GetOverlappingActors(OverlappingActors);
-
-				for (int i = 0; i < OverlappingActors.Num(); i++) {
-					//don't allow a player to build a structure that overlaps with another player
-					if (OverlappingActors[i]->IsA(AFortniteCloneCharacter::StaticClass())) {
-						Wall->Destroy();
-						return;
-					}
-				}
-				State->MaterialCounts[CurrentBuildingMaterial] -= 10;
+			int PieceIndex = State->InBuildMode ? GetBuildPieceIndex(State->BuildMode) : -1;
+			if (PieceIndex == -1 || CurrentBuildingMaterial < 0 || CurrentBuildingMaterial > 2 || State->Inventory->GetCount(EInventoryItem::Material, CurrentBuildingMaterial) < 10) {
+				return;
 			}
-			else if (State->InBuildMode && State->BuildMode == FString("Ramp") && State->MaterialCounts[CurrentBuildingMaterial] >= 10) {
-				TArray<AActor*> OverlappingActors;
-
-				ABuildingActor* Ramp = GetWorld()->SpawnActor<ABuildingActor>(RampClasses[CurrentBuildingMaterial], GetActorLocation() + (GetActorForwardVector() * 100) + (DirectionVector * 3), GetActorRotation().Add(0, 90, 0));
-
-				Ramp->GetOverlappingActors(OverlappingActors);
-
-				for (int i = 0; i < OverlappingActors.Num(); i++) {
-					//don't allow a player to build a structure that overlaps with another player
-					if (OverlappingActors[i]->IsA(AFortniteCloneCharacter::StaticClass())) {
-						Ramp->Destroy();
-						return;
-					}
-				}
-				State->MaterialCounts[CurrentBuildingMaterial] -= 10;
+			const TArray<TSubclassOf<ABuildingActor>>& BuildingClasses = PieceIndex == 0 ? WallClasses : (PieceIndex == 1 ? RampClasses : FloorClasses);
+			if (!BuildingClasses.IsValidIndex(CurrentBuildingMaterial) || BuildingClasses[CurrentBuildingMaterial] == nullptr) {
+				return;
 			}
-			else if (State->InBuildMode && State->BuildMode == FString("Floor") && State->MaterialCounts[CurrentBuildingMaterial] >= 10) {
-				TArray<AActor*> OverlappingActors;
-				ABuildingActor* Floor = GetWorld()->SpawnActor<ABuildingActor>(FloorClasses[CurrentBuildingMaterial], GetActorLocation() + (GetActorForwardVector() * 120) + (DirectionVector * 3), GetActorRotation().Add(0, 90, 0));
-
-				Floor->GetOverlappingActors(OverlappingActors);
-
-				for (int i = 0; i < OverlappingActors.Num(); i++) {
-					//don't allow a player to build a structure that overlaps with another player
-					if (OverlappingActors[i]->IsA(AFortniteCloneCharacter::StaticClass())) {
-						Floor->Destroy();
-						return;
-					}
-				}
-				State->MaterialCounts[CurrentBuildingMaterial] -= 10;
+			// the preview is client side only, so the placement is recomputed and validated here before anything is spawned
+			AFortniteCloneGameMode* GameMode = GetWorld()->GetAuthGameMode<AFortniteCloneGameMode>();
+			FTransform BuildTransform;
+			uint64 BuildSlot = GetBuildSlot(PieceIndex, BuildTransform);
+			if (GameMode == nullptr || !GameMode->CanBuildInSlot(BuildSlot, BuildTransform)) {
+				return;
+			}
+			ABuildingActor* Structure = Cast<ABuildingActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, BuildingClasses[CurrentBuildingMaterial], BuildTransform, ESpawnActorCollisionHandlingMethod::AlwaysSpawn));
+			if (Structure == nullptr) {
+				return;
 			}
+			//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
+			Structure->BuildGridSlot = BuildSlot;
+			Structure->InBuildGrid = true;
+			UGameplayStatics::FinishSpawningActor(Structure, BuildTransform);
+			GameMode->BuildGrid.Occupy(BuildSlot);
+			State->Inventory->AddCount(EInventoryItem::Material, CurrentBuildingMaterial, -10);
+			FMatchEventLog::Get().Record(EMatchEvent::Build, (uint8)PieceIndex, (uint8)CurrentBuildingMaterial, State->PlayerId, -1, 10, BuildTransform.GetLocation());
 		}
 	}
 }
@@ -1385,97 +1305,57 @@ bool AFortniteCloneCharacter::ServerBuildStructures_Validate() {
 }
 
 void AFortniteCloneCharacter::ServerFireWeapons_Implementation() {
-	if (GetController()) {
+	SCOPE_CYCLE_COUNTER(STAT_FireWeapons);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::FireWeapons);
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
 			//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(GetNetMode()) + FString(" Current weapon ") + FString::FromInt(State->CurrentWeapon));
-			if (State->HoldingWeapon) {
-				if (State->CurrentWeapon > 0 && State->CurrentWeapon < 3 && CurrentWeapon->CurrentBulletCount <= 0) {
+			if (State->HoldingWeapon && CurrentWeapon) {
+				// everything that differs between weapons comes from the definition, looked up by weapon type
+				const UWeaponDefinition* Definition = UFortniteCloneAssetManager::GetWeaponDefinition(State->CurrentWeapon);
+				if (Definition == nullptr) {
+					return;
+				}
+				if (Definition->UsesAmmunition && CurrentWeapon->CurrentBulletCount <= 0) {
 					// no bullets in magazine, need to reload
 					ServerReloadWeapons();
 					return;
 				}
-				if (State->JustReloadedRifle || State->JustReloadedShotgun) {
+				if (Definition->UsesAmmunition && State->IsActionActive(Definition->ReloadAction)) {
 					return; //currently reloading
 				}
-				if (State->AimedIn) {
-					if (State->CurrentWeapon == 1) {
-						if (State->JustShotRifle) {
-							return;
-						}
-						NetMulticastPlayShootRifleIronsightsAnimation();
-						CurrentWeapon->CurrentBulletCount--;
-						State->EquippedWeaponsClips[CurrentWeaponType]--;
-						State->JustShotRifle = true;
-						FTimerHandle RifleTimerHandle;
-						GetWorldTimerManager().SetTimer(RifleTimerHandle, this, &AFortniteCloneCharacter::ServerRifleTimeOut, 0.233f, false);
-					}
-					else if (State->CurrentWeapon == 2) {
-						if (State->JustShotShotgun) {
-							return;
-						}
-						NetMulticastPlayShootShotgunIronsightsAnimation();
-						CurrentWeapon->CurrentBulletCount--;
-						State->EquippedWeaponsClips[CurrentWeaponType]--;
-						State->JustShotShotgun = true;
-						FTimerHandle ShotgunTimerHandle;
-						GetWorldTimerManager().SetTimer(ShotgunTimerHandle, this, &AFortniteCloneCharacter::ServerShotgunTimeOut, 1.3f, false);
-					}
+				if (State->IsActionActive(Definition->FireAction)) {
+					return;
 				}
-				else {
-					if (State->CurrentWeapon == 0) {
-						//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, "pickaxe swung");
-						if (State->JustSwungPickaxe) {
-							return;
-						}
-						NetMulticastPlayPickaxeSwingAnimation();
-						State->JustSwungPickaxe = true;
-						FTimerHandle PickaxeTimerHandle;
-						GetWorldTimerManager().SetTimer(PickaxeTimerHandle, this, &AFortniteCloneCharacter::ServerPickaxeTimeOut, 0.403f, false);
-					}
-					if (State->CurrentWeapon == 1) {
-						if (State->JustShotRifle) {
-							return;
-						}
-						NetMulticastPlayShootRifleAnimation();
-						CurrentWeapon->CurrentBulletCount--;
-						State->EquippedWeaponsClips[CurrentWeaponType]--;
-						State->JustShotRifle = true;
-						FTimerHandle RifleTimerHandle;
-						GetWorldTimerManager().SetTimer(RifleTimerHandle, this, &AFortniteCloneCharacter::ServerRifleTimeOut, 0.233f, false);
-					}
-					else if (State->CurrentWeapon == 2) {
-						if (State->JustShotShotgun) {
-							return;
-						}
-						NetMulticastPlayShootShotgunAnimation();
-						CurrentWeapon->CurrentBulletCount--;
-						State->EquippedWeaponsClips[CurrentWeaponType]--;
-						State->JustShotShotgun = true;
-						FTimerHandle ShotgunTimerHandle;
-						GetWorldTimerManager().SetTimer(ShotgunTimerHandle, this, &AFortniteCloneCharacter::ServerShotgunTimeOut, 1.3f, false);
-					}
-
+				PlayActionMontage(State->AimedIn ? Definition->AimedFireMontage : Definition->FireMontage);
+				if (Definition->UsesAmmunition) {
+					CurrentWeapon->CurrentBulletCount--;
+					State->Inventory->AddCount(EInventoryItem::Clip, CurrentWeaponType, -1);
 				}
+				State->StartAction(Definition->FireAction, Definition->FireInterval);
 				FName WeaponSocketName = TEXT("hand_right_socket");
 				FVector BulletLocation = GetMesh()->GetSocketLocation(WeaponSocketName);
 				FRotator BulletRotation = GetMesh()->GetSocketRotation(WeaponSocketName);
 				FVector DirectionVector = FVector(0, AimYaw * 70, AimPitch * 20);
 				FRotator DirectionRotation = FRotator(BulletRotation.Pitch, GetActorRotation().Yaw, BulletRotation.Roll);
-				APlayerController* PlayerController = Cast<APlayerController>(GetController());
-				FRotator CameraRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
-				FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation() + GetActorForwardVector() * 210 + FVector(0,0,50);
+				// the camera manager's view for players, the eyes of the pawn for bots
+				FVector CameraLocation;
+				FRotator CameraRotation;
+				GetController()->GetPlayerViewPoint(CameraLocation, CameraRotation);
+				CameraLocation += GetActorForwardVector() * 210 + FVector(0,0,50);
 				FVector CameraDirection = GetActorLocation() - CameraLocation;
 				CameraDirection.Normalize();
-				FTransform SpawnTransform(CameraRotation + FRotator(2,-1.25,0), BulletLocation);
-				auto Bullet = Cast<AProjectileActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, CurrentWeapon->BulletClass, SpawnTransform));
-				if (Bullet != nullptr)
-				{
-					//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-					Bullet->Weapon = CurrentWeapon;
-					Bullet->WeaponHolder = this;
-
-					UGameplayStatics::FinishSpawningActor(Bullet, SpawnTransform);
+				FRotator BulletDirection = CameraRotation + FRotator(2, -1.25, 0);
+				AFortniteCloneGameMode* GameMode = GetWorld()->GetAuthGameMode<AFortniteCloneGameMode>();
+				if (GameMode && GameMode->ProjectileManager) {
+					// the projectiles are simulated by the manager, clients only get one tracer per shot
+					const float SpreadRadians = FMath::DegreesToRadians(Definition->Spread);
+					for (int i = 0; i < FMath::Max(Definition->PelletCount, 1); i++) {
+						FRotator PelletDirection = SpreadRadians > 0 ? FMath::VRandCone(BulletDirection.Vector(), SpreadRadians).Rotation() : BulletDirection;
+						GameMode->ProjectileManager->FireProjectile(CurrentWeapon->BulletClass, Definition, BulletLocation, PelletDirection, this, CurrentWeapon);
+					}
+					NetMulticastSpawnTracer(BulletLocation, BulletDirection, CurrentWeapon->BulletClass, Definition->WeaponId);
 				}
 			}
 		}
@@ -1487,21 +1367,21 @@ bool AFortniteCloneCharacter::ServerFireWeapons_Validate() {
 }
 
 void AFortniteCloneCharacter::ServerHealWithBandage_Implementation() {
-	if (GetController()) {
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State && State->HoldingBandage) {
-			if (State->BandageCount < 1) {
+			if (State->Inventory->GetCount(EInventoryItem::Bandage, 0) < 1) {
 				return; // player has no bandages to use
 			}
 
-			if (State->JustUsedBandage) {
+			if (State->IsActionActive(EPlayerAction::UseBandage)) {
 				return;
 			}
-			NetMulticastPlayUseBandageAnimation();
-			State->JustUsedBandage = true;
-			State->BandageCount--;
-			FTimerHandle BandageTimerHandle;
-			GetWorldTimerManager().SetTimer(BandageTimerHandle, this, &AFortniteCloneCharacter::ServerBandageTimeOut, 3.321f, false);
+			PlayActionMontage(ECharacterMontage::UseBandage);
+			State->Inventory->AddCount(EInventoryItem::Bandage, 0, -1);
+			State->StartAction(EPlayerAction::UseBandage, 3.321f);
+			// the heal lands when the bandage animation finishes
+			BandageHealPending = true;
 		}
 	}
 }
@@ -1512,127 +1392,35 @@ bool AFortniteCloneCharacter::ServerHealWithBandage_Validate() {
 
 
 void AFortniteCloneCharacter::ServerReloadWeapons_Implementation() {
-	if (GetController()) {
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			if (State->CurrentWeapon > 2 || State->CurrentWeapon < 1) {
-				return; // can only reload if holding a assault rifle or shotgun
+			const UWeaponDefinition* Definition = UFortniteCloneAssetManager::GetWeaponDefinition(State->CurrentWeapon);
+			if (Definition == nullptr || !Definition->UsesAmmunition || CurrentWeapon == nullptr) {
+				return; // can only reload weapons that take ammunition
 			}
-			if (State->JustShotRifle || State->JustShotShotgun || State->JustReloadedRifle || State->JustReloadedShotgun) {
+			if (State->IsActionActive(Definition->FireAction) || State->IsActionActive(Definition->ReloadAction)) {
 				return; // currently reloading or just shot
 			}
-			if (State->AimedIn) {
-				if (State->CurrentWeapon == 1) {
-					if (State->JustShotRifle) {
-						return;
-					}
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] <= 0) {
-						return; // no ammo left
-					}
-
-					int BulletsNeeded = CurrentWeapon->MagazineSize - CurrentWeapon->CurrentBulletCount;
-					if (BulletsNeeded == 0) {
-						return; // magazine is full
-					}
-
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] < BulletsNeeded) {
-						BulletsNeeded = State->EquippedWeaponsAmmunition[State->CurrentWeapon];
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] = 0;
-					}
-					else {
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] -= BulletsNeeded;
-					}
-					NetMulticastPlayReloadRifleIronsightsAnimation();
-					CurrentWeapon->CurrentBulletCount += BulletsNeeded;
-					State->EquippedWeaponsClips[State->CurrentWeapon] += BulletsNeeded;
-					State->JustReloadedRifle = true;
-					FTimerHandle RifleTimerHandle;
-					GetWorldTimerManager().SetTimer(RifleTimerHandle, this, &AFortniteCloneCharacter::ServerRifleReloadTimeOut, 2.167f, false);
-				}
-				else if (State->CurrentWeapon == 2) {
-					if (State->JustShotShotgun) {
-						return;
-					}
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] <= 0) {
-						return; // no ammo left
-					}
-
-					int BulletsNeeded = CurrentWeapon->MagazineSize - CurrentWeapon->CurrentBulletCount;
-					if (BulletsNeeded == 0) {
-						return; // magazine is full
-					}
-
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] < BulletsNeeded) {
-						BulletsNeeded = State->EquippedWeaponsAmmunition[State->CurrentWeapon];
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] = 0;
-					}
-					else {
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] -= BulletsNeeded;
-					}
-					NetMulticastPlayReloadShotgunIronsightsAnimation();
-					CurrentWeapon->CurrentBulletCount += BulletsNeeded;
-					State->EquippedWeaponsClips[State->CurrentWeapon] += BulletsNeeded;
-					State->JustReloadedShotgun = true;
-					FTimerHandle ShotgunTimerHandle;
-					GetWorldTimerManager().SetTimer(ShotgunTimerHandle, this, &AFortniteCloneCharacter::ServerShotgunReloadTimeOut, 4.3f, false);
-				}
+			int Ammunition = State->Inventory->GetCount(EInventoryItem::Ammunition, State->CurrentWeapon);
+			if (Ammunition <= 0) {
+				return; // no ammo left
+			}
+			int BulletsNeeded = Definition->GetMagazineSize(CurrentWeapon) - CurrentWeapon->CurrentBulletCount;
+			if (BulletsNeeded <= 0) {
+				return; // magazine is full
+			}
+			if (Ammunition < BulletsNeeded) {
+				BulletsNeeded = Ammunition;
+				State->Inventory->SetCount(EInventoryItem::Ammunition, State->CurrentWeapon, 0);
 			}
 			else {
-				if (State->CurrentWeapon == 1) {
-					if (State->JustShotRifle) {
-						return;
-					}
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] <= 0) {
-						return; // no ammo left
-					}
-					int BulletsNeeded = CurrentWeapon->MagazineSize - CurrentWeapon->CurrentBulletCount;
-					if (BulletsNeeded == 0) {
-						return; // magazine is full
-					}
-					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(State->EquippedWeaponsAmmunition[State->CurrentWeapon]));
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] < BulletsNeeded) {
-						BulletsNeeded = State->EquippedWeaponsAmmunition[State->CurrentWeapon];
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] = 0;
-					}
-					else {
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] -= BulletsNeeded;
-					}
-					NetMulticastPlayReloadRifleAnimation();
-					CurrentWeapon->CurrentBulletCount += BulletsNeeded;
-					State->EquippedWeaponsClips[State->CurrentWeapon] += BulletsNeeded;
-					//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(CurrentWeapon->CurrentBulletCount));
-					State->JustReloadedRifle = true;
-					FTimerHandle RifleTimerHandle;
-					GetWorldTimerManager().SetTimer(RifleTimerHandle, this, &AFortniteCloneCharacter::ServerRifleReloadTimeOut, 2.167f, false);
-				}
-				else if (State->CurrentWeapon == 2) {
-					if (State->JustShotShotgun) {
-						return;
-					}
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] <= 0) {
-						return; // no ammo left
-					}
-					int BulletsNeeded = CurrentWeapon->MagazineSize - CurrentWeapon->CurrentBulletCount;
-					if (BulletsNeeded == 0) {
-						return; // magazine is full
-					}
-
-					if (State->EquippedWeaponsAmmunition[State->CurrentWeapon] < BulletsNeeded) {
-						BulletsNeeded = State->EquippedWeaponsAmmunition[State->CurrentWeapon];
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] = 0;
-					}
-					else {
-						State->EquippedWeaponsAmmunition[State->CurrentWeapon] -= BulletsNeeded;
-					}
-					NetMulticastPlayReloadShotgunAnimation();
-					CurrentWeapon->CurrentBulletCount += BulletsNeeded;
-					State->EquippedWeaponsClips[State->CurrentWeapon] += BulletsNeeded;
-					State->JustReloadedShotgun = true;
-					FTimerHandle ShotgunTimerHandle;
-					GetWorldTimerManager().SetTimer(ShotgunTimerHandle, this, &AFortniteCloneCharacter::ServerShotgunReloadTimeOut, 4.3f, false);
-				}
-
+				State->Inventory->AddCount(EInventoryItem::Ammunition, State->CurrentWeapon, -BulletsNeeded);
 			}
+			PlayActionMontage(State->AimedIn ? Definition->AimedReloadMontage : Definition->ReloadMontage);
+			CurrentWeapon->CurrentBulletCount += BulletsNeeded;
+			State->Inventory->AddCount(EInventoryItem::Clip, State->CurrentWeapon, BulletsNeeded);
+			State->StartAction(Definition->ReloadAction, Definition->ReloadTime);
 		}
 	}
 }
@@ -1641,124 +1429,45 @@ bool AFortniteCloneCharacter::ServerReloadWeapons_Validate() {
 	return true;
 }
 
-void AFortniteCloneCharacter::ServerSwitchToPickaxe_Implementation() {
-	if (GetController()) {
+void AFortniteCloneCharacter::ServerSwitchToWeapon_Implementation(int WeaponId) {
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			if (State->CurrentWeapon == 0 && !State->InBuildMode) {
-				return; // currently holding a pickaxe while not in build mode
+			if (State->CurrentWeapon == WeaponId && !State->InBuildMode) {
+				return; // currently holding the weapon while not in build mode
 			}
 			if (State->HoldingWeapon && State->AimedIn) {
 				return; // currently aimed down sight
 			}
-			if (State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun || State->JustShotRifle || State->JustShotShotgun) {
-				return; // currently healing or currently reloading or just shot a weapon
+			if (UFortniteCloneAssetManager::GetWeaponDefinition(WeaponId) == nullptr || (WeaponId != 0 && !State->Inventory->HasWeapon(WeaponId))) {
+				return; // no such weapon or doesn't have one, everyone has a pickaxe
 			}
-			else {
-				if (State->InBuildMode) {
-					State->InBuildMode = false;
-					State->BuildMode = FString("None");
-					if (BuildingPreview) {
-						BuildingPreview->Destroy(); //destroy the last wall preview
-					}
-				}
-				if (CurrentWeapon) {
-					State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-					CurrentWeapon->Destroy();
-					CurrentWeapon = nullptr;
-				}
-				if (CurrentHealingItem) {
-					CurrentHealingItem->Destroy();
-					CurrentHealingItem = nullptr;
-				}
-				FName WeaponSocketName = TEXT("hand_right_socket");
-				FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-				FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-				CurrentWeapon = Cast<AWeaponActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, WeaponClasses[0], SpawnTransform));
-				CurrentWeaponType = 0;
-				if (CurrentWeapon != nullptr)
-				{
-					//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-					CurrentWeapon->Holder = this;
-
-					UGameplayStatics::FinishSpawningActor(CurrentWeapon, SpawnTransform);
-				}
-				UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentWeapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-				WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
-
-				HoldingWeapon = true;
-				AimedIn = false;
-				HoldingWeaponType = 1;
-				State->HoldingWeapon = true;
-				State->HoldingBandage = false;
-				State->CurrentWeapon = 0;
+			if (State->IsActionActive(EPlayerAction::UseBandage) || IsReloading(State) || IsFiringOtherWeapon(State, WeaponId)) {
+				return; // currently healing or currently reloading or just used another weapon
 			}
+			if (State->InBuildMode) {
+				State->InBuildMode = false;
+				State->BuildMode = FString("None");
+			}
+			EquipFromPool(WeaponId, State);
 		}
 	}
 }
 
+bool AFortniteCloneCharacter::ServerSwitchToWeapon_Validate(int WeaponId) {
+	return true;
+}
+
+void AFortniteCloneCharacter::ServerSwitchToPickaxe_Implementation() {
+	ServerSwitchToWeapon(0);
+}
+
 bool AFortniteCloneCharacter::ServerSwitchToPickaxe_Validate() {
 	return true;
 }
 
 void AFortniteCloneCharacter::ServerSwitchToRifle_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			if (State->CurrentWeapon == 1 && !State->InBuildMode) {
-				return; // currently holding a assault rifle while not in build mode
-			}
-			if (State->HoldingWeapon && State->AimedIn) {
-				return; // currently aimed down sight
-			}
-			if (!State->EquippedWeapons.Contains(1) || State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun || State->JustSwungPickaxe || State->JustShotShotgun) {
-				return; // already holding the assault rifle or doesn't have one or is currently healing or currently reloading or swinging pickaxe or shooting shotgun
-			}
-			else {
-				if (State->InBuildMode) {
-					State->InBuildMode = false;
-					State->BuildMode = FString("None");
-					if (BuildingPreview) {
-						BuildingPreview->Destroy(); //destroy the last wall preview
-					}
-				}
-				if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-					State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-				}
-				if (CurrentWeapon) {
-					CurrentWeapon->Destroy();
-					CurrentWeapon = nullptr;
-				}
-				if (CurrentHealingItem) {
-					CurrentHealingItem->Destroy();
-					CurrentHealingItem = nullptr;
-				}
-				FName WeaponSocketName = TEXT("hand_right_socket");
-				FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-				FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-				CurrentWeapon = Cast<AWeaponActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, WeaponClasses[1], SpawnTransform));
-				CurrentWeaponType = 1;
-				if (CurrentWeapon != nullptr)
-				{
-					//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-					CurrentWeapon->Holder = this;
-					CurrentWeapon->CurrentBulletCount = State->EquippedWeaponsClips[CurrentWeaponType];
-					UGameplayStatics::FinishSpawningActor(CurrentWeapon, SpawnTransform);
-				}
-				UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentWeapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-				WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
-
-				HoldingWeapon = true;
-				AimedIn = false;
-				HoldingWeaponType = 1;
-				State->HoldingWeapon = true;
-				State->HoldingBandage = false;
-				State->CurrentWeapon = 1;
-			}
-		}
-	}
+	ServerSwitchToWeapon(1);
 }
 
 bool AFortniteCloneCharacter::ServerSwitchToRifle_Validate() {
@@ -1766,62 +1475,7 @@ bool AFortniteCloneCharacter::ServerSwitchToRifle_Validate() {
 }
 
 void AFortniteCloneCharacter::ServerSwitchToShotgun_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			if (State->CurrentWeapon == 2 && !State->InBuildMode) {
-				return; // currently holding a shotgun while not in build mode
-			}
-			if (State->HoldingWeapon && State->AimedIn) {
-				return; // currently aimed down sight
-			}
-			if (!State->EquippedWeapons.Contains(2) || State->JustUsedBandage || State->JustReloadedRifle || State->JustReloadedShotgun || State->JustSwungPickaxe || State->JustShotRifle) {
-				return; // already holding the pickaxe or doesn't have one or is currently healing or currently reloading or swinging pickaxe or just shot rifle
-			}
-			else {
-				if (State->InBuildMode) {
-					State->InBuildMode = false;
-					State->BuildMode = FString("None");
-					if (BuildingPreview) {
-						BuildingPreview->Destroy(); //destroy the last wall preview
-					}
-				}
-				if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-					State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-				}
-				if (CurrentWeapon) {
-					CurrentWeapon->Destroy();
-					CurrentWeapon = nullptr;
-				}
-				if (CurrentHealingItem) {
-					CurrentHealingItem->Destroy();
-					CurrentHealingItem = nullptr;
-				}
-				FName WeaponSocketName = TEXT("hand_right_socket");
-				FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-				FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-				CurrentWeapon = Cast<AWeaponActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, WeaponClasses[2], SpawnTransform));
-				CurrentWeaponType = 2;
-				if (CurrentWeapon != nullptr)
-				{
-					//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-					CurrentWeapon->Holder = this;
-					CurrentWeapon->CurrentBulletCount = State->EquippedWeaponsClips[CurrentWeaponType];
-					UGameplayStatics::FinishSpawningActor(CurrentWeapon, SpawnTransform);
-				}
-				UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentWeapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-				WeaponStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, WeaponSocketName);
-
-				HoldingWeapon = true;
-				AimedIn = false;
-				HoldingWeaponType = 1;
-				State->HoldingWeapon = true;
-				State->HoldingBandage = false;
-				State->CurrentWeapon = 2;
-			}
-		}
-	}
+	ServerSwitchToWeapon(2);
 }
 
 bool AFortniteCloneCharacter::ServerSwitchToShotgun_Validate() {
@@ -1829,10 +1483,10 @@ bool AFortniteCloneCharacter::ServerSwitchToShotgun_Validate() {
 }
 
 void AFortniteCloneCharacter::ServerSwitchToBandage_Implementation() {
-	if (GetController()) {
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State) {
-			if (State->JustReloadedRifle || State->JustReloadedShotgun || State->JustSwungPickaxe || State->JustShotRifle || State->JustShotShotgun) {
+			if (IsReloading(State) || IsFiringOtherWeapon(State, -1)) {
 				return; //currently reloading weapons or s winging pickaxe
 			}
 			if (State->HoldingWeapon && State->AimedIn) {
@@ -1845,40 +1499,8 @@ void AFortniteCloneCharacter::ServerSwitchToBandage_Implementation() {
 				if (State->InBuildMode) {
 					State->InBuildMode = false;
 					State->BuildMode = FString("None");
-					if (BuildingPreview) {
-						BuildingPreview->Destroy(); //destroy the last wall preview
-					}
-				}
-				//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::FromInt(CurrentWeaponType));
-				if (CurrentWeapon && CurrentWeaponType > 0 && CurrentWeaponType < 3) {
-					State->EquippedWeaponsClips[CurrentWeaponType] = CurrentWeapon->CurrentBulletCount;
-				}
-				if (CurrentWeapon) {
-					CurrentWeapon->Destroy();
-					CurrentWeapon = nullptr;
-				}
-				FName BandageSocketName = TEXT("hand_left_socket");
-				FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
-
-				FTransform SpawnTransform(GetActorRotation(), GetActorLocation());
-				CurrentHealingItem = Cast<AHealingActor>(UGameplayStatics::BeginDeferredActorSpawnFromClass(this, BandageClass, SpawnTransform));
-				CurrentWeaponType = -1;
-				if (CurrentHealingItem != nullptr)
-				{
-					//spawnactor has no way of passing parameters so need to use begindeferredactorspawn and finishspawningactor
-					CurrentHealingItem->Holder = this;
-
-					UGameplayStatics::FinishSpawningActor(CurrentHealingItem, SpawnTransform);
 				}
-				UStaticMeshComponent* HealingItemStaticMeshComponent = Cast<UStaticMeshComponent>(CurrentHealingItem->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-				HealingItemStaticMeshComponent->AttachToComponent(this->GetMesh(), AttachmentRules, BandageSocketName);
-
-				HoldingWeapon = false;
-				AimedIn = false;
-				HoldingWeaponType = 0;
-				State->HoldingWeapon = false;
-				State->HoldingBandage = true;
-				State->CurrentWeapon = -1;
+				EquipFromPool(-1, State);
 			}
 		}
 	}
@@ -1889,7 +1511,7 @@ bool AFortniteCloneCharacter::ServerSwitchToBandage_Validate() {
 }
 
 void AFortniteCloneCharacter::ServerChangeBuildingMaterial_Implementation() {
-	if (GetController()) {
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State && State->InBuildMode) {
 			if (CurrentBuildingMaterial == 2) {
@@ -1907,7 +1529,7 @@ bool AFortniteCloneCharacter::ServerChangeBuildingMaterial_Validate() {
 }
 
 void AFortniteCloneCharacter::ServerAimDownSights_Implementation() {
-	if (GetController()) {
+	if (GetController() && IsAlive()) {
 		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
 		if (State && State->HoldingWeapon && State->CurrentWeapon != 0) {
 			AimedIn = true;
@@ -1941,122 +1563,6 @@ bool AFortniteCloneCharacter::ServerAimHipFire_Validate() {
 	return true;
 }
 
-void AFortniteCloneCharacter::ServerPickaxeTimeOut_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			State->JustSwungPickaxe = false;
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerPickaxeTimeOut_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerRifleTimeOut_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			State->JustShotRifle = false;
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerRifleTimeOut_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerShotgunTimeOut_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			State->JustShotShotgun = false;
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerShotgunTimeOut_Validate() {
-	return true;
-}
-
-
-void AFortniteCloneCharacter::ServerBandageTimeOut_Implementation() {
-	if (Health < 100) {
-		if (Health + 15 > 100) {
-			Health = 100;
-		}
-		else {
-			Health += 15;
-		}
-	}
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			State->JustUsedBandage = false;
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerBandageTimeOut_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerApplyStormDamage_Implementation() {
-	if (InStorm) {
-		//get storm actor and get its damage component and apply the damage to the player's health
-		Health -= CurrentStorm->Damage;
-		if (Health <= 0) {
-			if (BuildingPreview) {
-				BuildingPreview->Destroy();
-			}
-			if (CurrentWeapon) {
-				CurrentWeapon->Destroy();
-			}
-			if (CurrentHealingItem) {
-				CurrentHealingItem->Destroy();
-			}
-			if (GetController()) {
-				AFortniteClonePlayerController* FortniteClonePlayerController = Cast<AFortniteClonePlayerController>(GetController());
-				if (FortniteClonePlayerController) {
-					FortniteClonePlayerController->ServerSwitchToSpectatorMode();
-				}
-			}
-			Destroy();
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerApplyStormDamage_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerRifleReloadTimeOut_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			State->JustReloadedRifle = false;
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerRifleReloadTimeOut_Validate() {
-	return true;
-}
-
-void AFortniteCloneCharacter::ServerShotgunReloadTimeOut_Implementation() {
-	if (GetController()) {
-		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(GetController()->PlayerState);
-		if (State) {
-			State->JustReloadedShotgun = false;
-		}
-	}
-}
-
-bool AFortniteCloneCharacter::ServerShotgunReloadTimeOut_Validate() {
-	return true;
-}
-
 void AFortniteCloneCharacter::ClientCameraAimIn_Implementation() {
 	FollowCamera->FieldOfView = 45;
 }
@@ -2065,52 +1571,13 @@ void AFortniteCloneCharacter::ClientCameraAimOut_Implementation() {
 	FollowCamera->FieldOfView = 90;
 }
 
-void AFortniteCloneCharacter::NetMulticastPlayPickaxeSwingAnimation_Implementation() {
-	PlayAnimMontage(PickaxeSwingingAnimation, 1.f, NAME_None);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayShootRifleAnimation_Implementation() {
-	PlayAnimMontage(RifleHipShootingAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayShootShotgunAnimation_Implementation() {
-	PlayAnimMontage(ShotgunHipShootingAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayShootRifleIronsightsAnimation_Implementation() {
-	PlayAnimMontage(RifleIronsightsShootingAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayShootShotgunIronsightsAnimation_Implementation() {
-	PlayAnimMontage(ShotgunIronsightsShootingAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayUseBandageAnimation_Implementation() {
-	PlayAnimMontage(HealingAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayReloadRifleAnimation_Implementation() {
-	PlayAnimMontage(RifleHipReloadAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayReloadRifleIronsightsAnimation_Implementation() {
-	PlayAnimMontage(RifleIronsightsReloadAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayReloadShotgunAnimation_Implementation() {
-	PlayAnimMontage(ShotgunHipReloadAnimation);
-}
-
-void AFortniteCloneCharacter::NetMulticastPlayReloadShotgunIronsightsAnimation_Implementation() {
-	PlayAnimMontage(ShotgunIronsightsReloadAnimation);
-}
-
-void AFortniteCloneCharacter::ClientDrawHitMarker_Implementation() {
-	if (GetController()) {
-		APlayerController* PlayerController = Cast<APlayerController>(GetController());
-		if (PlayerController->GetHUD()) {
-			AFortniteCloneHUD* FortniteCloneHUD = Cast<AFortniteCloneHUD>(PlayerController->GetHUD());
-			FortniteCloneHUD->DrawHitMarker();
-		}
+void AFortniteCloneCharacter::NetMulticastSpawnTracer_Implementation(FVector_NetQuantize Location, FRotator Rotation, TSubclassOf<AProjectileActor> BulletClass, int WeaponId) {
+	if (GetNetMode() == NM_DedicatedServer || BulletClass == nullptr) {
+		return;
+	}
+	FTransform SpawnTransform(Rotation, Location);
+	ATracerActor* Tracer = GetWorld()->SpawnActor<ATracerActor>(ATracerActor::StaticClass(), SpawnTransform);
+	if (Tracer != nullptr) {
+		Tracer->Initialize(BulletClass, UFortniteCloneAssetManager::GetWeaponDefinition(WeaponId));
 	}
 }
\ No newline at end of file
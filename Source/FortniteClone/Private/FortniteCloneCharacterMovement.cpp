@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FortniteCloneCharacterMovement.h"
+#include "FortniteCloneCharacter.h"
+
+UFortniteCloneCharacterMovement::UFortniteCloneCharacterMovement()
+{
+	bWantsToWalk = false;
+	bWantsToRun = false;
+}
+
+void UFortniteCloneCharacterMovement::UpdateFromCompressedFlags(uint8 Flags) {
+	Super::UpdateFromCompressedFlags(Flags);
+	bWantsToWalk = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+	bWantsToRun = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
+}
+
+FNetworkPredictionData_Client* UFortniteCloneCharacterMovement::GetPredictionData_Client() const {
+	if (ClientPredictionData == nullptr) {
+		UFortniteCloneCharacterMovement* MutableThis = const_cast<UFortniteCloneCharacterMovement*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_FortniteClone(*this);
+	}
+	return ClientPredictionData;
+}
+
+int8 UFortniteCloneCharacterMovement::QuantizeMoveAxis(float AccelerationAxis) const {
+	// ignore the small off-axis noise left over from the quantized acceleration sent with each move
+	const float Threshold = GetMaxAcceleration() * 0.05f;
+	if (AccelerationAxis > Threshold) {
+		return 90;
+	}
+	if (AccelerationAxis < -Threshold) {
+		return -90;
+	}
+	return 0;
+}
+
+void UFortniteCloneCharacterMovement::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) {
+	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+	AFortniteCloneCharacter* FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(CharacterOwner);
+	if (FortniteCloneCharacter && FortniteCloneCharacter->Role > ROLE_SimulatedProxy) {
+		// the move direction is derived from the acceleration already carried by the move, relative to the view yaw
+		const FRotator YawRotation(0, FortniteCloneCharacter->GetControlRotation().Yaw, 0);
+		const FVector LocalAcceleration = YawRotation.UnrotateVector(GetCurrentAcceleration());
+		FortniteCloneCharacter->SetLocomotionState(bWantsToWalk, bWantsToRun, QuantizeMoveAxis(LocalAcceleration.Y), QuantizeMoveAxis(LocalAcceleration.X));
+	}
+}
+
+void FSavedMove_FortniteClone::Clear() {
+	Super::Clear();
+	bSavedWantsToWalk = false;
+	bSavedWantsToRun = false;
+}
+
+uint8 FSavedMove_FortniteClone::GetCompressedFlags() const {
+	uint8 Result = Super::GetCompressedFlags();
+	if (bSavedWantsToWalk) {
+		Result |= FLAG_Custom_0;
+	}
+	if (bSavedWantsToRun) {
+		Result |= FLAG_Custom_1;
+	}
+	return Result;
+}
+
+bool FSavedMove_FortniteClone::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* Character, float MaxDelta) const {
+	// a change in locomotion flags has to go out as its own move, otherwise the moves can be merged and sent together
+	const FSavedMove_FortniteClone* NewFortniteCloneMove = static_cast<const FSavedMove_FortniteClone*>(NewMove.Get());
+	if (bSavedWantsToWalk != NewFortniteCloneMove->bSavedWantsToWalk || bSavedWantsToRun != NewFortniteCloneMove->bSavedWantsToRun) {
+		return false;
+	}
+	return Super::CanCombineWith(NewMove, Character, MaxDelta);
+}
+
+void FSavedMove_FortniteClone::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) {
+	Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+	UFortniteCloneCharacterMovement* MovementComponent = Cast<UFortniteCloneCharacterMovement>(Character->GetCharacterMovement());
+	if (MovementComponent) {
+		bSavedWantsToWalk = MovementComponent->bWantsToWalk;
+		bSavedWantsToRun = MovementComponent->bWantsToRun;
+	}
+}
+
+void FSavedMove_FortniteClone::PrepMoveFor(ACharacter* Character) {
+	Super::PrepMoveFor(Character);
+	UFortniteCloneCharacterMovement* MovementComponent = Cast<UFortniteCloneCharacterMovement>(Character->GetCharacterMovement());
+	if (MovementComponent) {
+		MovementComponent->bWantsToWalk = bSavedWantsToWalk;
+		MovementComponent->bWantsToRun = bSavedWantsToRun;
+	}
+}
+
+FNetworkPredictionData_Client_FortniteClone::FNetworkPredictionData_Client_FortniteClone(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_FortniteClone::AllocateNewMove() {
+	return FSavedMovePtr(new FSavedMove_FortniteClone());
+}
@@ -3,6 +3,7 @@
 #include "FortniteCloneGameMode.h"
 #include "FortniteCloneCharacter.h"
 #include "FortniteClonePlayerState.h"
+#include "FortniteCloneGameState.h"
 #include "FortniteCloneHUD.h"
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
@@ -12,14 +13,50 @@
 #include "GameLiftClientSDK/Public/GameLiftClientApi.h"
 #include "StormActor.h"
 #include "FortniteClonePlayerController.h"
+#include "ProjectileManager.h"
+#include "WeaponActor.h"
+#include "HealingActor.h"
+#include "Components/CapsuleComponent.h"
+#include "EngineUtils.h"
+#include "FortniteCloneBotController.h"
+#include "FortniteCloneReplicationGraph.h"
+#include "MatchProfiler.h"
+#include "MatchEventLog.h"
+#include "Engine/Engine.h"
+#include "Misc/Paths.h"
+#include "Misc/CoreDelegates.h"
 
 DEFINE_LOG_CATEGORY(LogMyServer);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Awake Replicated Actors"), STAT_AwakeReplicatedActors, STATGROUP_FortniteClone);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Replicated Actors"), STAT_DormantReplicatedActors, STATGROUP_FortniteClone);
+DECLARE_CYCLE_STAT(TEXT("Storm Damage"), STAT_StormDamage, STATGROUP_FortniteClone);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Actors Spawned"), STAT_ActorsSpawned, STATGROUP_FortniteClone);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Actors Destroyed"), STAT_ActorsDestroyed, STATGROUP_FortniteClone);
+
+static FAutoConsoleCommandWithWorldAndArgs SpawnBotsCommand(
+	TEXT("fc.SpawnBots"),
+	TEXT("Spawns bots on the server for load testing. Usage: fc.SpawnBots <Count> [BuildFight|StormRush|Wander]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World) {
+		AFortniteCloneGameMode* GameMode = World ? World->GetAuthGameMode<AFortniteCloneGameMode>() : nullptr;
+		if (GameMode == nullptr || Args.Num() < 1) {
+			return;
+		}
+		GameMode->SpawnBots(FCString::Atoi(*Args[0]), AFortniteCloneBotController::ParseProfile(Args.Num() > 1 ? Args[1] : FString()));
+	})
+);
+
 AFortniteCloneGameMode::AFortniteCloneGameMode()
 {
 	// set default pawn class to our Blueprinted character
 	Initialized = false;
 	TimeSinceInitialization = 0;
+	ProjectileManager = nullptr;
+	MaxDeathsPerFrame = 16;
+	StormDamageInterval = 1.0f;
+	// damage from the whole frame is applied after movement and projectiles have updated
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/ThirdPersonCPP/Blueprints/ThirdPersonCharacter"));
 	static ConstructorHelpers::FClassFinder<APawn> SpectatorPawnBPClass(TEXT("/Game/Blueprints/BP_Spectator"));
 	if (PlayerPawnBPClass.Class != NULL && SpectatorPawnBPClass.Class != NULL)
@@ -27,6 +64,7 @@ AFortniteCloneGameMode::AFortniteCloneGameMode()
 		DefaultPawnClass = PlayerPawnBPClass.Class;
 		SpectatorClass = SpectatorPawnBPClass.Class;
 		PlayerStateClass = AFortniteClonePlayerState::StaticClass();
+		GameStateClass = AFortniteCloneGameState::StaticClass();
 		PlayerControllerClass = AFortniteClonePlayerController::StaticClass();
 		HUDClass = AFortniteCloneHUD::StaticClass();
 	}
@@ -95,10 +133,76 @@ AFortniteCloneGameMode::AFortniteCloneGameMode()
 
 void AFortniteCloneGameMode::BeginPlay() {
 	Super::BeginPlay();
+	ProjectileManager = GetWorld()->SpawnActor<AProjectileManager>(AProjectileManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+	//one storm damage pass for everyone instead of a timer per character
+	FTimerHandle StormDamageTimerHandle;
+	GetWorldTimerManager().SetTimer(StormDamageTimerHandle, this, &AFortniteCloneGameMode::ApplyStormDamage, StormDamageInterval, true);
+	FTimerHandle DormancyStatsTimerHandle;
+	GetWorldTimerManager().SetTimer(DormancyStatsTimerHandle, this, &AFortniteCloneGameMode::UpdateDormancyStats, 1.0f, true);
+	FMatchProfiler::Get().Reset();
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &AFortniteCloneGameMode::OnActorSpawned));
+	// actors placed in the level were never spawned, their destroys are counted as well
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It) {
+		It->OnDestroyed.AddDynamic(this, &AFortniteCloneGameMode::OnActorDestroyed);
+	}
+	BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &AFortniteCloneGameMode::OnBeginFrame);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &AFortniteCloneGameMode::OnEndFrame);
+	// a headless server started with -bots=N fills itself for load testing
+	int BotCount = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("bots="), BotCount) && BotCount > 0) {
+		FString BotProfile;
+		FParse::Value(FCommandLine::Get(), TEXT("botprofile="), BotProfile);
+		SpawnBots(BotCount, AFortniteCloneBotController::ParseProfile(BotProfile));
+	}
 	//NetMulticastSpawnStorm();
 }
 
+void AFortniteCloneGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	FMatchProfiler& Profiler = FMatchProfiler::Get();
+	if (!Profiler.IsEmpty()) {
+		// one file per match so builds can be compared against each other
+		FString Path = FPaths::ProfilingDir() / FString::Printf(TEXT("Match_%s.csv"), *FDateTime::Now().ToString());
+		if (Profiler.WriteCsv(Path)) {
+			UE_LOG(LogMyServer, Log, TEXT("Match profile written to %s"), *Path);
+		}
+		else {
+			UE_LOG(LogMyServer, Warning, TEXT("Could not write match profile to %s"), *Path);
+		}
+		Profiler.Reset();
+	}
+	FMatchEventLog::Get().Stop();
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFortniteCloneGameMode::OnActorSpawned(AActor* Actor) {
+	INC_DWORD_STAT(STAT_ActorsSpawned);
+	FMatchProfiler::Get().CountSpawn();
+	// the engine's deleted actor event only fires in the editor, so every actor reports its own destroy
+	Actor->OnDestroyed.AddDynamic(this, &AFortniteCloneGameMode::OnActorDestroyed);
+}
+
+void AFortniteCloneGameMode::OnActorDestroyed(AActor* Actor) {
+	INC_DWORD_STAT(STAT_ActorsDestroyed);
+	FMatchProfiler::Get().CountDestroy();
+}
+
+void AFortniteCloneGameMode::OnBeginFrame() {
+	FMatchProfiler::Get().BeginFrame();
+}
+
+void AFortniteCloneGameMode::OnEndFrame() {
+	FMatchProfiler::Get().EndFrame();
+}
+
 void AFortniteCloneGameMode::StartPlay() {
+	// started before any actor begins play so the storm's first phase is in the log
+	FString EventLogPath = FPaths::ProfilingDir() / FString::Printf(TEXT("Events_%s.fcevents"), *FDateTime::Now().ToString());
+	if (!FMatchEventLog::Get().Start(EventLogPath)) {
+		UE_LOG(LogMyServer, Warning, TEXT("Could not create match event log %s"), *EventLogPath);
+	}
 	Super::StartPlay();
 	//UGameplayStatics::OpenLevel((UObject*)GetWorld(), FName(TEXT("Level_BattleRoyale")));
 }
@@ -116,19 +220,7 @@ void AFortniteCloneGameMode::PostLogin(APlayerController *NewPlayer) {
 	}*/
 	AFortniteClonePlayerController* FortniteClonePlayerController = Cast<AFortniteClonePlayerController>(NewPlayer);
 	if (!Initialized && GetNumPlayers() >= 2) {
-		Initialized = true;
-		TArray<AActor*> StormActors;
-		UGameplayStatics::GetAllActorsOfClass(GetWorld(), AStormActor::StaticClass(), StormActors);
-		if (StormActors.Num() > 0) {
-			if (StormActors[0] != nullptr) {
-				CurrentStorm = Cast<AStormActor>(StormActors[0]);
-			}
-		}
-		FTimerHandle StormSetupTimerHandle;
-		GetWorldTimerManager().SetTimer(StormSetupTimerHandle, this, &AFortniteCloneGameMode::GameModeStartStorm, 30.0f, false);
-
-		FTimerHandle InitializationTimerHandle;
-		GetWorldTimerManager().SetTimer(InitializationTimerHandle, this, &AFortniteCloneGameMode::TickInitializationClock, 1.0f, true);
+		InitializeMatch();
 	}
 	if (FortniteClonePlayerController) {
 		if (TimeSinceInitialization > 150) {
@@ -138,6 +230,49 @@ void AFortniteCloneGameMode::PostLogin(APlayerController *NewPlayer) {
 			FortniteClonePlayerController->SpawnAsSpectator = false;
 		}
 		//FortniteClonePlayerController->SpawnAsSpectator = true;
+		AFortniteCloneGameState* FortniteCloneGameState = GetGameState<AFortniteCloneGameState>();
+		if (FortniteCloneGameState) {
+			FortniteCloneGameState->PlayerJoined(FortniteClonePlayerController->SpawnAsSpectator);
+		}
+	}
+}
+
+void AFortniteCloneGameMode::InitializeMatch() {
+	Initialized = true;
+	TArray<AActor*> StormActors;
+	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AStormActor::StaticClass(), StormActors);
+	if (StormActors.Num() > 0) {
+		if (StormActors[0] != nullptr) {
+			CurrentStorm = Cast<AStormActor>(StormActors[0]);
+		}
+	}
+	FTimerHandle StormSetupTimerHandle;
+	GetWorldTimerManager().SetTimer(StormSetupTimerHandle, this, &AFortniteCloneGameMode::GameModeStartStorm, 30.0f, false);
+
+	FTimerHandle InitializationTimerHandle;
+	GetWorldTimerManager().SetTimer(InitializationTimerHandle, this, &AFortniteCloneGameMode::TickInitializationClock, 1.0f, true);
+}
+
+void AFortniteCloneGameMode::SpawnBots(int Count, EBotProfile Profile) {
+	AFortniteCloneGameState* FortniteCloneGameState = GetGameState<AFortniteCloneGameState>();
+	for (int i = 0; i < Count; i++) {
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AFortniteCloneBotController* Bot = GetWorld()->SpawnActor<AFortniteCloneBotController>(AFortniteCloneBotController::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParameters);
+		if (Bot == nullptr) {
+			continue;
+		}
+		Bot->Profile = Profile;
+		// spawned at a player start with the default pawn, the same as a player joining
+		RestartPlayer(Bot);
+		if (FortniteCloneGameState) {
+			FortniteCloneGameState->PlayerJoined(false);
+		}
+	}
+	UE_LOG(LogMyServer, Log, TEXT("Spawned %d bots"), Count);
+	// a bot-only server never sees the two logins that start the storm
+	if (!Initialized) {
+		InitializeMatch();
 	}
 }
 
@@ -162,6 +297,17 @@ void AFortniteCloneGameMode::PreLogin(const FString& Options, const FString& Add
 #endif
 }
 
+void AFortniteCloneGameMode::Logout(AController* Exiting) {
+	AFortniteClonePlayerController* FortniteClonePlayerController = Cast<AFortniteClonePlayerController>(Exiting);
+	AFortniteCloneGameState* FortniteCloneGameState = GetGameState<AFortniteCloneGameState>();
+	if (FortniteClonePlayerController && FortniteCloneGameState) {
+		// late joiners may not have switched to spectating yet
+		bool WasSpectator = FortniteClonePlayerController->SpawnAsSpectator || (FortniteClonePlayerController->PlayerState && FortniteClonePlayerController->PlayerState->bIsSpectator);
+		FortniteCloneGameState->PlayerLeft(WasSpectator);
+	}
+	Super::Logout(Exiting);
+}
+
 void AFortniteCloneGameMode::NetMulticastSpawnStorm_Implementation() {
 	GetWorld()->SpawnActor<AStormActor>(AStormActor::StaticClass(), FVector(-440, -1450, 10000), FRotator::ZeroRotator);
 }
@@ -180,4 +326,197 @@ void AFortniteCloneGameMode::TickInitializationClock_Implementation() {
 
 bool AFortniteCloneGameMode::TickInitializationClock_Validate() {
 	return true;
-}
\ No newline at end of file
+}
+
+bool AFortniteCloneGameMode::CanBuildInSlot(uint64 SlotKey, const FTransform& PieceTransform) const {
+	if (BuildGrid.IsOccupied(SlotKey)) {
+		return false;
+	}
+	for (TActorIterator<AFortniteCloneCharacter> It(GetWorld()); It; ++It) {
+		//don't allow a player to build a structure that overlaps with a player, building through yourself would leave you stuck inside it
+		UCapsuleComponent* Capsule = It->GetCapsuleComponent();
+		if (Capsule && FBuildGrid::CapsuleIntersectsPiece(SlotKey, PieceTransform, Capsule->GetComponentLocation(), Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void AFortniteCloneGameMode::Tick(float DeltaSeconds) {
+	Super::Tick(DeltaSeconds);
+	ProcessDamageQueue();
+}
+
+void AFortniteCloneGameMode::QueueDamage(AFortniteCloneCharacter* Victim, float Damage, AFortniteCloneCharacter* DamageCauser) {
+	if (Victim == nullptr) {
+		return;
+	}
+	FQueuedDamage QueuedDamage;
+	QueuedDamage.Victim = Victim;
+	QueuedDamage.DamageCauser = DamageCauser;
+	QueuedDamage.Damage = Damage;
+	DamageQueue.Add(QueuedDamage);
+}
+
+void AFortniteCloneGameMode::UpdateDormancyStats() {
+	uint32 AwakeActors = 0;
+	uint32 DormantActors = 0;
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It) {
+		if (!It->GetIsReplicated() || It->IsPendingKill()) {
+			continue;
+		}
+		if (It->NetDormancy > DORM_Awake) {
+			DormantActors++;
+		}
+		else {
+			AwakeActors++;
+		}
+	}
+	SET_DWORD_STAT(STAT_AwakeReplicatedActors, AwakeActors);
+	SET_DWORD_STAT(STAT_DormantReplicatedActors, DormantActors);
+}
+
+void AFortniteCloneGameMode::ApplyStormDamage() {
+	SCOPE_CYCLE_COUNTER(STAT_StormDamage);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::StormDamage);
+	if (CurrentStorm == nullptr) {
+		TArray<AActor*> StormActors;
+		UGameplayStatics::GetAllActorsOfClass(GetWorld(), AStormActor::StaticClass(), StormActors);
+		if (StormActors.Num() == 0 || StormActors[0] == nullptr) {
+			return;
+		}
+		CurrentStorm = Cast<AStormActor>(StormActors[0]);
+	}
+
+	StormCandidates.Reset();
+	StormCandidateX.Reset();
+	StormCandidateY.Reset();
+	for (TActorIterator<AFortniteCloneCharacter> It(GetWorld()); It; ++It) {
+		if (It->IsPendingKill() || It->Health <= 0) {
+			continue;
+		}
+		const FVector Location = It->GetActorLocation();
+		StormCandidates.Add(*It);
+		StormCandidateX.Add(Location.X);
+		StormCandidateY.Add(Location.Y);
+	}
+
+	// the radius is evaluated once for the whole pass, the loop below is only arithmetic over contiguous floats
+	const float Radius = CurrentStorm->GetCurrentRadius();
+	const float RadiusSquared = Radius * Radius;
+	const float CenterX = CurrentStorm->Phase.Center.X;
+	const float CenterY = CurrentStorm->Phase.Center.Y;
+	const float Damage = CurrentStorm->Damage;
+	for (int i = 0; i < StormCandidates.Num(); i++) {
+		const float DX = StormCandidateX[i] - CenterX;
+		const float DY = StormCandidateY[i] - CenterY;
+		const bool OutsideCircle = DX * DX + DY * DY > RadiusSquared;
+		StormCandidates[i]->InStorm = OutsideCircle;
+		if (OutsideCircle) {
+			QueueDamage(StormCandidates[i], Damage, nullptr);
+		}
+	}
+}
+
+void AFortniteCloneGameMode::ProcessDamageQueue() {
+	for (int i = 0; i < DamageQueue.Num(); i++) {
+		AFortniteCloneCharacter* Victim = DamageQueue[i].Victim.Get();
+		if (Victim == nullptr || Victim->IsPendingKill() || Victim->Health <= 0) {
+			continue; // already dead or waiting for its death to be handled
+		}
+		Victim->Health -= DamageQueue[i].Damage;
+		Victim->OnRep_Health();
+		AFortniteCloneCharacter* DamageCauser = DamageQueue[i].DamageCauser.Get();
+		FMatchEventLog::Get().Record(EMatchEvent::Damage, 0, 0, FMatchEventLog::GetPlayerId(DamageCauser), FMatchEventLog::GetPlayerId(Victim), DamageQueue[i].Damage, Victim->GetActorLocation());
+		AFortniteClonePlayerController* ShooterController = DamageCauser ? Cast<AFortniteClonePlayerController>(DamageCauser->GetController()) : nullptr;
+		if (ShooterController) {
+			// hit markers are gathered per shooter and sent once the whole queue is applied
+			ShooterController->AddHitFeedback(Victim, DamageQueue[i].Damage, Victim->Health <= 0);
+			HitFeedbackControllers.AddUnique(ShooterController);
+		}
+		if (Victim->Health <= 0) {
+			PendingDeaths.Add(DamageQueue[i]);
+		}
+	}
+	DamageQueue.Reset();
+	for (int i = 0; i < HitFeedbackControllers.Num(); i++) {
+		if (HitFeedbackControllers[i]) {
+			HitFeedbackControllers[i]->FlushHitFeedback();
+		}
+	}
+	HitFeedbackControllers.Reset();
+
+	int Processed = 0;
+	for (; Processed < PendingDeaths.Num() && Processed < MaxDeathsPerFrame; Processed++) {
+		AFortniteCloneCharacter* Victim = PendingDeaths[Processed].Victim.Get();
+		if (Victim && !Victim->IsPendingKill()) {
+			HandleDeath(Victim, PendingDeaths[Processed].DamageCauser.Get());
+		}
+	}
+	PendingDeaths.RemoveAt(0, Processed, false);
+}
+
+void AFortniteCloneGameMode::HandleDeath(AFortniteCloneCharacter* Victim, AFortniteCloneCharacter* Killer) {
+	// recorded first, the victim loses its player state once it is destroyed
+	FMatchEventLog::Get().Record(EMatchEvent::Kill, 0, 0, FMatchEventLog::GetPlayerId(Killer != Victim ? Killer : nullptr), FMatchEventLog::GetPlayerId(Victim), 0, Victim->GetActorLocation());
+	// everything left in the victim's equipment pool is destroyed along with it
+	DropLoot(Victim);
+	AFortniteClonePlayerController* FortniteClonePlayerController = Cast<AFortniteClonePlayerController>(Victim->GetController());
+	if (FortniteClonePlayerController) {
+		FortniteClonePlayerController->ServerSwitchToSpectatorMode();
+	}
+	AController* VictimController = Victim->GetController();
+	const bool IsBot = Cast<AFortniteCloneBotController>(VictimController) != nullptr;
+	Victim->Destroy();
+	if (IsBot) {
+		// bots don't spectate
+		VictimController->Destroy();
+	}
+	AFortniteCloneGameState* FortniteCloneGameState = GetGameState<AFortniteCloneGameState>();
+	if (FortniteCloneGameState) {
+		if (IsBot) {
+			FortniteCloneGameState->BotDied();
+		}
+		else {
+			FortniteCloneGameState->PlayerDied();
+		}
+	}
+	if (Killer && Killer != Victim && Killer->GetController() && Killer->GetController()->PlayerState) {
+		AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(Killer->GetController()->PlayerState);
+		if (State) {
+			State->KillCount++;
+			State->OnRep_KillCount();
+		}
+	}
+}
+
+void AFortniteCloneGameMode::DropLoot(AFortniteCloneCharacter* Victim) {
+	AWeaponActor* Weapon = Victim->CurrentWeapon;
+	if (Weapon == nullptr) {
+		return;
+	}
+	Victim->CurrentWeapon = nullptr;
+	if (Victim->WeaponPool.IsValidIndex(Weapon->WeaponType)) {
+		Victim->WeaponPool[Weapon->WeaponType] = nullptr;
+	}
+	if (Weapon->WeaponType == 0) {
+		// everyone spawns with a pickaxe, so it is not worth dropping
+		Weapon->Destroy();
+		return;
+	}
+	// a weapon without a holder can be picked up by overlapping it
+	UStaticMeshComponent* WeaponStaticMeshComponent = Cast<UStaticMeshComponent>(Weapon->GetComponentByClass(UStaticMeshComponent::StaticClass()));
+	if (WeaponStaticMeshComponent) {
+		WeaponStaticMeshComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+	Weapon->SetActorLocation(Victim->GetActorLocation());
+	Weapon->Holder = nullptr;
+	UFortniteCloneReplicationGraph* ReplicationGraph = UFortniteCloneReplicationGraph::Get(GetWorld());
+	if (ReplicationGraph) {
+		// back in the grid for whoever is nearby, the victim and its dependents are about to go
+		ReplicationGraph->RouteEquipment(Weapon);
+		ReplicationGraph->UpdateHeldEquipment(Victim);
+	}
+	// goes dormant again once the drop has been sent
+	Weapon->SetNetDormancy(DORM_DormantAll);
+}
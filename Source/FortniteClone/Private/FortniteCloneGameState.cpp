@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FortniteCloneGameState.h"
+#include "UnrealNetwork.h"
+#include "CharacterSignificanceManager.h"
+#include "TimerManager.h"
+
+AFortniteCloneGameState::AFortniteCloneGameState()
+{
+	AliveCount = 0;
+	SpectatorCount = 0;
+	SignificanceManager = nullptr;
+	SignificanceUpdateInterval = 0.25f;
+}
+
+void AFortniteCloneGameState::BeginPlay() {
+	Super::BeginPlay();
+	// the game state exists on the server and every client, so it runs both rankings
+	if (GetNetMode() != NM_Standalone) {
+		SignificanceManager = NewObject<UCharacterSignificanceManager>(this);
+		FTimerHandle SignificanceTimerHandle;
+		GetWorldTimerManager().SetTimer(SignificanceTimerHandle, this, &AFortniteCloneGameState::UpdateSignificance, SignificanceUpdateInterval, true);
+	}
+}
+
+void AFortniteCloneGameState::UpdateSignificance() {
+	SignificanceManager->Update();
+}
+
+void AFortniteCloneGameState::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AFortniteCloneGameState, AliveCount);
+	DOREPLIFETIME(AFortniteCloneGameState, SpectatorCount);
+}
+
+void AFortniteCloneGameState::OnRep_AliveCount() {
+	OnAliveCountChanged.Broadcast(AliveCount);
+}
+
+void AFortniteCloneGameState::OnRep_SpectatorCount() {
+	OnSpectatorCountChanged.Broadcast(SpectatorCount);
+}
+
+void AFortniteCloneGameState::PlayerJoined(bool AsSpectator) {
+	if (AsSpectator) {
+		SetCounts(AliveCount, SpectatorCount + 1);
+	}
+	else {
+		SetCounts(AliveCount + 1, SpectatorCount);
+	}
+}
+
+void AFortniteCloneGameState::PlayerDied() {
+	SetCounts(FMath::Max(AliveCount - 1, 0), SpectatorCount + 1);
+}
+
+void AFortniteCloneGameState::BotDied() {
+	SetCounts(FMath::Max(AliveCount - 1, 0), SpectatorCount);
+}
+
+void AFortniteCloneGameState::PlayerLeft(bool WasSpectator) {
+	if (WasSpectator) {
+		SetCounts(AliveCount, FMath::Max(SpectatorCount - 1, 0));
+	}
+	else {
+		SetCounts(FMath::Max(AliveCount - 1, 0), SpectatorCount);
+	}
+}
+
+void AFortniteCloneGameState::SetCounts(int NewAliveCount, int NewSpectatorCount) {
+	// repnotifies don't run on the server, so a listen server's own UI is notified here
+	if (NewAliveCount != AliveCount) {
+		AliveCount = NewAliveCount;
+		OnRep_AliveCount();
+	}
+	if (NewSpectatorCount != SpectatorCount) {
+		SpectatorCount = NewSpectatorCount;
+		OnRep_SpectatorCount();
+	}
+}
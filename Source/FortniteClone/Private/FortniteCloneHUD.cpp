@@ -6,6 +6,11 @@
 #include "UObject/ConstructorHelpers.h"
 #include "Blueprint/UserWidget.h"
 #include "Engine.h"
+#include "HUDViewModel.h"
+#include "TransientWidgetPool.h"
+#include "FortniteCloneCharacter.h"
+#include "FortniteClonePlayerState.h"
+#include "HUDWidget.h"
 
 AFortniteCloneHUD::AFortniteCloneHUD()
 {
@@ -25,12 +30,19 @@ AFortniteCloneHUD::AFortniteCloneHUD()
 	MainMenuWidgetClass = MainMenuObj.Class;
 	static ConstructorHelpers::FClassFinder<UUserWidget> CountObj(TEXT("/Game/UI/Widgets/UI_RemainingPlayersCount"));
 	CountWidgetClass = CountObj.Class;
+	ViewModel = nullptr;
+	HitMarkerPool = nullptr;
+	HitMarkerPoolSize = 4;
+	MaxHitMarkers = 8;
 }
 
 void AFortniteCloneHUD::DrawHUD()
 {
 	Super::DrawHUD();
 	DrawCrosshair();
+	if (HitMarkerPool) {
+		HitMarkerPool->Update(GetWorld()->GetTimeSeconds());
+	}
 }
 
 void AFortniteCloneHUD::BeginPlay()
@@ -52,7 +64,16 @@ void AFortniteCloneHUD::BeginPlay()
 		PlayerController->bEnableMouseOverEvents = false; 
 		PlayerController->SetInputMode(FInputModeGameOnly());
 	}
+	// created before the widgets so they can bind to it when they are constructed
+	ViewModel = NewObject<UHUDViewModel>(this);
+	if (PlayerOwner) {
+		ViewModel->Refresh(Cast<AFortniteCloneCharacter>(PlayerOwner->GetPawn()), Cast<AFortniteClonePlayerState>(PlayerOwner->PlayerState));
+	}
 	DrawGameUI();
+	if (HitMarkerWidgetClass != nullptr && PlayerOwner) {
+		HitMarkerPool = NewObject<UTransientWidgetPool>(this);
+		HitMarkerPool->Init(PlayerOwner, HitMarkerWidgetClass, HitMarkerPoolSize, MaxHitMarkers);
+	}
 }
 
 void AFortniteCloneHUD::DrawCrosshair() {
@@ -70,16 +91,8 @@ void AFortniteCloneHUD::DrawCrosshair() {
 }
 
 void AFortniteCloneHUD::DrawHitMarker() {
-	if (HitMarkerWidgetClass != nullptr)
-	{
-		CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), HitMarkerWidgetClass);
-		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, "hitmarkerclass is not null");
-		if (CurrentWidget)
-		{
-			//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, "current widget is not null");
-			CurrentWidget->AddToViewport();
-			// TODO for later: Implement your own UUserWidget class to retrieve animation from a blueprint and play the animation here
-		}
+	if (HitMarkerPool) {
+		HitMarkerPool->Show();
 	}
 }
 
@@ -88,53 +101,24 @@ void AFortniteCloneHUD::DrawGameUI() {
 	/*if (CurrentWidget != nullptr) {
 		CurrentWidget->RemoveFromViewport();
 	}*/
-	if (HealthWidgetClass != nullptr)
-	{
-		CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), HealthWidgetClass);
-
-		if (CurrentWidget)
-		{
-			CurrentWidget->AddToViewport();
-		}
-	}
-
-	if (MaterialsWidgetClass != nullptr)
-	{
-		CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), MaterialsWidgetClass);
-
-		if (CurrentWidget)
-		{
-			CurrentWidget->AddToViewport();
-		}
-	}
-
-	if (ItemsWidgetClass != nullptr)
-	{
-		CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), ItemsWidgetClass);
+	// these widgets are driven by the view model, the remaining players count reads the game state itself
+	AddGameWidget(HealthWidgetClass, true);
+	AddGameWidget(MaterialsWidgetClass, true);
+	AddGameWidget(ItemsWidgetClass, true);
+	AddGameWidget(KillsWidgetClass, true);
+	AddGameWidget(CountWidgetClass, false);
+}
 
-		if (CurrentWidget)
-		{
-			CurrentWidget->AddToViewport();
-		}
+void AFortniteCloneHUD::AddGameWidget(TSubclassOf<UUserWidget> WidgetClass, bool UsesViewModel) {
+	if (WidgetClass == nullptr) {
+		return;
 	}
-
-	if (KillsWidgetClass != nullptr)
-	{
-		CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), KillsWidgetClass);
-
-		if (CurrentWidget)
-		{
-			CurrentWidget->AddToViewport();
-		}
+	if (UsesViewModel && !WidgetClass->IsChildOf(UHUDWidget::StaticClass())) {
+		// a widget that isn't a HUD widget never hears from the view model and falls back to polling through its property bindings
+		UE_LOG(LogMyGame, Warning, TEXT("HUD widget %s should be reparented to UHUDWidget, it polls its values every frame"), *WidgetClass->GetName());
 	}
-
-	if (CountWidgetClass != nullptr)
-	{
-		CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), CountWidgetClass);
-
-		if (CurrentWidget)
-		{
-			CurrentWidget->AddToViewport();
-		}
+	CurrentWidget = CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
+	if (CurrentWidget) {
+		CurrentWidget->AddToViewport();
 	}
 }
\ No newline at end of file
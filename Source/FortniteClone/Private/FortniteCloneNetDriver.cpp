@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FortniteCloneNetDriver.h"
+#include "BandwidthAccounting.h"
+#include "FortniteCloneCharacter.h"
+#include "FortniteClonePlayerState.h"
+#include "WeaponActor.h"
+#include "HealingActor.h"
+#include "AmmunitionActor.h"
+#include "MaterialActor.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetworkObjectList.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+static FAutoConsoleCommandWithArgs NetAccountingCommand(
+	TEXT("fc.NetAccounting"),
+	TEXT("Server bandwidth accounting per connection, RPC and property. Usage: fc.NetAccounting on|off|flush|dump [Rows]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args) {
+		FBandwidthAccounting& Accounting = FBandwidthAccounting::Get();
+		const FString Action = Args.Num() > 0 ? Args[0] : FString(TEXT("dump"));
+		if (Action.Equals(TEXT("on"), ESearchCase::IgnoreCase)) {
+			Accounting.SetEnabled(true);
+		}
+		else if (Action.Equals(TEXT("off"), ESearchCase::IgnoreCase)) {
+			Accounting.SetEnabled(false);
+		}
+		else if (Action.Equals(TEXT("flush"), ESearchCase::IgnoreCase)) {
+			Accounting.Flush();
+		}
+		else {
+			Accounting.Dump(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 20);
+		}
+	})
+);
+
+void UFortniteCloneNetDriver::ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject) {
+	FBandwidthAccounting& Accounting = FBandwidthAccounting::Get();
+	if (!Accounting.IsEnabled() || !IsServer()) {
+		Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+		return;
+	}
+	// client RPCs only go to the owner, so only multicasts need every connection measured
+	UNetConnection* OwningConnection = (Function->FunctionFlags & FUNC_NetMulticast) ? nullptr : Actor->GetNetConnection();
+	if (OwningConnection) {
+		const int64 BitsBefore = GetSentBits(OwningConnection);
+		Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+		Accounting.AddRPCBits(Function, OwningConnection, GetSentBits(OwningConnection) - BitsBefore);
+		return;
+	}
+	ConnectionBits.SetNum(ClientConnections.Num(), false);
+	for (int i = 0; i < ClientConnections.Num(); i++) {
+		ConnectionBits[i] = GetSentBits(ClientConnections[i]);
+	}
+	Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+	for (int i = 0; i < ClientConnections.Num() && i < ConnectionBits.Num(); i++) {
+		Accounting.AddRPCBits(Function, ClientConnections[i], GetSentBits(ClientConnections[i]) - ConnectionBits[i]);
+	}
+}
+
+int32 UFortniteCloneNetDriver::ServerReplicateActors(float DeltaSeconds) {
+	FBandwidthAccounting& Accounting = FBandwidthAccounting::Get();
+	if (!Accounting.IsEnabled()) {
+		return Super::ServerReplicateActors(DeltaSeconds);
+	}
+	// dormant pickups send nothing, so only awake actors are compared
+	for (const TSharedPtr<FNetworkObjectInfo>& ObjectInfo : GetNetworkObjectList().GetActiveObjects()) {
+		AActor* Actor = ObjectInfo->Actor;
+		if (Actor && !Actor->IsPendingKill() && IsAccountedClass(Actor)) {
+			Accounting.SampleProperties(Actor, CountOpenChannels(Actor));
+		}
+	}
+	ConnectionBits.SetNum(ClientConnections.Num(), false);
+	for (int i = 0; i < ClientConnections.Num(); i++) {
+		ConnectionBits[i] = GetSentBits(ClientConnections[i]);
+	}
+	const int32 Updated = Super::ServerReplicateActors(DeltaSeconds);
+	for (int i = 0; i < ClientConnections.Num() && i < ConnectionBits.Num(); i++) {
+		Accounting.AddConnectionBits(ClientConnections[i], GetSentBits(ClientConnections[i]) - ConnectionBits[i]);
+	}
+	Accounting.Tick(FPlatformTime::Seconds());
+	return Updated;
+}
+
+int64 UFortniteCloneNetDriver::GetSentBits(UNetConnection* Connection) {
+	// OutBytes only counts flushed packets and is reset by the connection's tick, which runs after both measured calls
+	return (int64)Connection->OutBytes * 8 + Connection->SendBuffer.GetNumBits();
+}
+
+bool UFortniteCloneNetDriver::IsAccountedClass(AActor* Actor) {
+	return Actor->IsA<AFortniteCloneCharacter>() || Actor->IsA<AFortniteClonePlayerState>() || Actor->IsA<AWeaponActor>()
+		|| Actor->IsA<AHealingActor>() || Actor->IsA<AAmmunitionActor>() || Actor->IsA<AMaterialActor>();
+}
+
+int UFortniteCloneNetDriver::CountOpenChannels(AActor* Actor) const {
+	int OpenChannels = 0;
+	for (UNetConnection* Connection : ClientConnections) {
+		if (Connection->ActorChannels.Contains(Actor)) {
+			OpenChannels++;
+		}
+	}
+	return OpenChannels;
+}
@@ -2,12 +2,15 @@
 
 #include "FortniteClonePlayerController.h"
 #include "FortniteClonePlayerState.h"
+#include "FortniteCloneGameState.h"
 #include "FortniteCloneCharacter.h"
 #include "FortniteCloneSpectator.h"
 #include "GameFramework/PlayerState.h"
 #include "Engine.h"
 #include "StormActor.h"
 #include "UnrealNetwork.h"
+#include "FortniteCloneHUD.h"
+#include "MatchEventLog.h"
 
 AFortniteClonePlayerController::AFortniteClonePlayerController() {
 	/*AFortniteClonePlayerState* State= Cast<AFortniteClonePlayerState>(GetPlayerState());
@@ -17,8 +20,6 @@ AFortniteClonePlayerController::AFortniteClonePlayerController() {
 	//PlayerState->bIsSpectator = true;
 	 static ConstructorHelpers::FClassFinder<AFortniteCloneSpectator> PlayerSpectatorBP(TEXT("/Game/Blueprints/BP_Spectator"));
 	 PlayerSpectatorClass = PlayerSpectatorBP.Class;
-	 PlayerCount = 0;
-	 SpectatorCount = 0;
 	 Initialized = false;
 }
 
@@ -52,9 +53,6 @@ void AFortniteClonePlayerController::Tick(float DeltaTime) {
 void AFortniteClonePlayerController::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	DOREPLIFETIME(AFortniteClonePlayerController, PlayerCount);
-	DOREPLIFETIME(AFortniteClonePlayerController, SpectatorCount);
 }
 
 void AFortniteClonePlayerController::ServerSwitchToSpectatorMode_Implementation() {
@@ -67,18 +65,7 @@ void AFortniteClonePlayerController::ServerSwitchToSpectatorMode_Implementation(
 		//SetSpectatorPawn(Pawn);
 		Possess(Pawn);
 		Cast<AFortniteClonePlayerState>(PlayerState)->bIsSpectator = true; // ORDER MATTERS HERE, HAS TO BE SET AFTER POSSESSING A PAWN
-		FString LogMsg = FString("switch to spectator mode ") + FString::FromInt(GetNetMode());
-		UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-		LogMsg = FString("test ") + FString::FromInt(GetNetMode());
-		UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-		if (Cast<AFortniteClonePlayerState>(PlayerState)->bIsSpectator) {
-			LogMsg = FString("What a spectator");
-			UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-		}
-		else {
-			LogMsg = FString("What not a spectator");
-			UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
-		}
+		FMatchEventLog::Get().Record(EMatchEvent::Spectate, 0, 0, PlayerState->PlayerId, -1, 0, Pawn ? Pawn->GetActorLocation() : FVector::ZeroVector);
 	}
 }
 
@@ -86,57 +73,47 @@ bool AFortniteClonePlayerController::ServerSwitchToSpectatorMode_Validate() {
 	return true;
 }
 
-void AFortniteClonePlayerController::ServerGetNumPlayers_Implementation() {
-	int Count = 0;
-	//FLocalPlayerContext Context(this);
-	//UWorld* World = Context.GetWorld();
-	/*AGameState* GameState = Cast<AGameState>(GetWorld()->GetGameState());
-	if (GameState) {
-		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("Gamestate is not null"));
-		TArray<APlayerState*> States = GameState->PlayerArray;
-		for (int i = 0; i < States.Num(); i++) {
-			if (States[i]->bIsSpectator == false) {
-				Count++;
-			}
-		}
-	}
-	else {
-		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("Gamestate is null"));
-	}
-	PlayerCount = Count;*/
+void AFortniteClonePlayerController::ServerUpdateCountAfterDeath_Implementation() {
+	
 }
 
-bool AFortniteClonePlayerController::ServerGetNumPlayers_Validate() {
+bool AFortniteClonePlayerController::ServerUpdateCountAfterDeath_Validate() {
 	return true;
 }
 
-void AFortniteClonePlayerController::ServerGetNumSpectators_Implementation() {
-	int Count = 0;
-	//FLocalPlayerContext Context(this);
-	//UWorld* World = Context.GetWorld();
-	/*AGameState* GameState = Cast<AGameState>(GetWorld()->GetGameState);
-	if (GameState) {
-		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("Gamemode is not null"));
-		TArray<APlayerState*> States = GameState->PlayerArray;
-		for (int i = 0; i < States.Num(); i++) {
-			if (States[i]->bIsSpectator == true) {
-				Count++;
+void AFortniteClonePlayerController::AddHitFeedback(AActor* Target, float Damage, bool Killed) {
+	for (int i = 0; i < PendingHitFeedback.Num(); i++) {
+		if (PendingHitFeedback[i].Target == Target) {
+			// shotgun pellets and rifle bursts on the same target become one entry
+			PendingHitFeedback[i].Damage += Damage;
+			if (Killed) {
+				PendingHitFeedback[i].Flags |= FHitFeedback::Killed;
 			}
+			return;
 		}
 	}
-	SpectatorCount = Count;*/
-}
-
-bool AFortniteClonePlayerController::ServerGetNumSpectators_Validate() {
-	return true;
+	FHitFeedback Hit;
+	Hit.Target = Target;
+	Hit.Damage = Damage;
+	Hit.Flags = Killed ? FHitFeedback::Killed : 0;
+	PendingHitFeedback.Add(Hit);
 }
 
-void AFortniteClonePlayerController::ServerUpdateCountAfterDeath_Implementation() {
-	
+void AFortniteClonePlayerController::FlushHitFeedback() {
+	if (PendingHitFeedback.Num() == 0) {
+		return;
+	}
+	ClientReceiveHitFeedback(PendingHitFeedback);
+	PendingHitFeedback.Reset();
 }
 
-bool AFortniteClonePlayerController::ServerUpdateCountAfterDeath_Validate() {
-	return true;
+void AFortniteClonePlayerController::ClientReceiveHitFeedback_Implementation(const TArray<FHitFeedback>& Hits) {
+	AFortniteCloneHUD* FortniteCloneHUD = Cast<AFortniteCloneHUD>(GetHUD());
+	if (FortniteCloneHUD) {
+		for (int i = 0; i < Hits.Num(); i++) {
+			FortniteCloneHUD->DrawHitMarker();
+		}
+	}
 }
 
 int AFortniteClonePlayerController::GetKillCount() {
@@ -155,11 +132,21 @@ int AFortniteClonePlayerController::GetKillCount() {
 }
 
 int AFortniteClonePlayerController::GetPlayerCount() {
-	ServerGetNumPlayers();
-	return PlayerCount;
+	AFortniteCloneGameState* FortniteCloneGameState = GetWorld()->GetGameState<AFortniteCloneGameState>();
+	if (FortniteCloneGameState) {
+		return FortniteCloneGameState->AliveCount;
+	}
+	else {
+		return 0;
+	}
 }
 
 int AFortniteClonePlayerController::GetSpectatorCount() {
-	ServerGetNumSpectators();
-	return SpectatorCount;
+	AFortniteCloneGameState* FortniteCloneGameState = GetWorld()->GetGameState<AFortniteCloneGameState>();
+	if (FortniteCloneGameState) {
+		return FortniteCloneGameState->SpectatorCount;
+	}
+	else {
+		return 0;
+	}
 }
\ No newline at end of file
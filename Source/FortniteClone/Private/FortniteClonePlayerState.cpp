@@ -3,6 +3,10 @@
 #include "FortniteClonePlayerState.h"
 #include "UnrealNetwork.h"
 #include "FortniteCloneCharacter.h"
+#include "InventoryComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "HUDViewModel.h"
 
 AFortniteClonePlayerState::AFortniteClonePlayerState() {
 	InBuildMode = false;
@@ -10,24 +14,8 @@ AFortniteClonePlayerState::AFortniteClonePlayerState() {
 	HoldingWeapon = true; //when spawned, player is holding pickaxe
 	HoldingBandage = false;
 	AimedIn = false;
-	EquippedWeapons.Add(0); //pickaxe
-	EquippedWeaponsAmmunition.Add(0); // pickaxe
-	EquippedWeaponsAmmunition.Add(0); // assault rifle
-	EquippedWeaponsAmmunition.Add(0); // shotgun
-	EquippedWeaponsClips.Add(0); // pickaxe
-	EquippedWeaponsClips.Add(0); // assault rifle
-	EquippedWeaponsClips.Add(0); // shotgun
-	MaterialCounts.Add(0); // wood
-	MaterialCounts.Add(0); // stone
-	MaterialCounts.Add(0); // steel
+	Inventory = CreateDefaultSubobject<UInventoryComponent>(TEXT("Inventory"));
 	CurrentWeapon = 0;
-	BandageCount = 0;
-	JustShotRifle = false;
-	JustShotShotgun = false;
-	JustSwungPickaxe = false;
-	JustUsedBandage = false;
-	JustReloadedRifle = false;
-	JustReloadedShotgun = false;
 	KillCount = 0;
 }
 
@@ -39,18 +27,8 @@ void AFortniteClonePlayerState::GetLifetimeReplicatedProps(TArray< FLifetimeProp
 	DOREPLIFETIME(AFortniteClonePlayerState, BuildMode);
 	DOREPLIFETIME(AFortniteClonePlayerState, HoldingWeapon);
 	DOREPLIFETIME(AFortniteClonePlayerState, HoldingBandage);
-	DOREPLIFETIME(AFortniteClonePlayerState, EquippedWeapons);
-	DOREPLIFETIME(AFortniteClonePlayerState, EquippedWeaponsAmmunition);
-	DOREPLIFETIME(AFortniteClonePlayerState, EquippedWeaponsClips);
-	DOREPLIFETIME(AFortniteClonePlayerState, MaterialCounts);
 	DOREPLIFETIME(AFortniteClonePlayerState, CurrentWeapon);
-	DOREPLIFETIME(AFortniteClonePlayerState, BandageCount);
-	DOREPLIFETIME(AFortniteClonePlayerState, JustShotRifle);
-	DOREPLIFETIME(AFortniteClonePlayerState, JustShotShotgun);
-	DOREPLIFETIME(AFortniteClonePlayerState, JustSwungPickaxe);
-	DOREPLIFETIME(AFortniteClonePlayerState, JustUsedBandage);
-	DOREPLIFETIME(AFortniteClonePlayerState, JustReloadedRifle);
-	DOREPLIFETIME(AFortniteClonePlayerState, JustReloadedShotgun);
+	DOREPLIFETIME_CONDITION(AFortniteClonePlayerState, Cooldowns, COND_OwnerOnly);
 	DOREPLIFETIME(AFortniteClonePlayerState, KillCount);
 	DOREPLIFETIME(AFortniteClonePlayerState, bIsSpectator);
 }
@@ -61,4 +39,36 @@ void AFortniteClonePlayerState::Tick(float DeltaSeconds) {
 	if (FortniteCloneCharacter) {
 
 	}
-}
\ No newline at end of file
+}
+
+void AFortniteClonePlayerState::OnRep_KillCount() {
+	UHUDViewModel* ViewModel = UHUDViewModel::Get(Cast<APlayerController>(GetOwner()));
+	if (ViewModel) {
+		ViewModel->SetKillCount(KillCount);
+	}
+}
+
+float AFortniteClonePlayerState::GetActionTime() const {
+	AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+bool AFortniteClonePlayerState::IsActionActive(EPlayerAction Action) const {
+	return Cooldowns.IsActive(Action, GetActionTime());
+}
+
+bool AFortniteClonePlayerState::IsAnyActionActive() const {
+	return Cooldowns.IsAnyActive(GetActionTime());
+}
+
+void AFortniteClonePlayerState::StartAction(EPlayerAction Action, float Duration) {
+	Cooldowns.Start(Action, GetActionTime(), Duration);
+}
+
+void AFortniteClonePlayerState::CancelAction(EPlayerAction Action) {
+	Cooldowns.Cancel(Action);
+}
+
+void AFortniteClonePlayerState::CancelAllActions() {
+	Cooldowns.CancelAll();
+}
@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FortniteCloneReplicationGraph.h"
+#include "Engine.h"
+#include "GameFramework/PlayerState.h"
+#include "FortniteCloneCharacter.h"
+#include "WeaponActor.h"
+#include "HealingActor.h"
+#include "AmmunitionActor.h"
+#include "MaterialActor.h"
+#include "BuildingActor.h"
+#include "StormActor.h"
+
+UFortniteCloneReplicationGraph::UFortniteCloneReplicationGraph()
+{
+	// the map spans roughly -10000 to 60000 on X and -65000 to 17000 on Y
+	GridCellSize = 10000.0f;
+	SpatialBiasX = -10000.0f;
+	SpatialBiasY = -65000.0f;
+	GridNode = nullptr;
+	AlwaysRelevantNode = nullptr;
+}
+
+void UFortniteCloneReplicationGraph::InitGlobalActorClassSettings() {
+	Super::InitGlobalActorClassSettings();
+
+	ClassRepNodePolicies.Set(AFortniteCloneCharacter::StaticClass(), EClassRepNodeMapping::Spatialize_Dynamic);
+	// dropped weapons and bandages sit in the grid, held ones follow their holder instead
+	ClassRepNodePolicies.Set(AWeaponActor::StaticClass(), EClassRepNodeMapping::Equipment);
+	ClassRepNodePolicies.Set(AHealingActor::StaticClass(), EClassRepNodeMapping::Equipment);
+	// pickups, harvestables and building pieces never move and only change when they are hit, picked up or destroyed
+	ClassRepNodePolicies.Set(AAmmunitionActor::StaticClass(), EClassRepNodeMapping::Spatialize_Dormancy);
+	ClassRepNodePolicies.Set(AMaterialActor::StaticClass(), EClassRepNodeMapping::Spatialize_Dormancy);
+	ClassRepNodePolicies.Set(ABuildingActor::StaticClass(), EClassRepNodeMapping::Spatialize_Dormancy);
+	ClassRepNodePolicies.Set(AStormActor::StaticClass(), EClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), EClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(APlayerController::StaticClass(), EClassRepNodeMapping::NotRouted);
+
+	const float ServerMaxTickRate = NetDriver->NetServerMaxTickRate;
+	for (TObjectIterator<UClass> It; It; ++It) {
+		UClass* Class = *It;
+		AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (!ActorCDO || !ActorCDO->GetIsReplicated()) {
+			continue;
+		}
+		// skip the classes the editor leaves behind when recompiling blueprints
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_"))) {
+			continue;
+		}
+		const EClassRepNodeMapping Policy = GetMappingPolicy(Class);
+		const bool Spatialize = Policy == EClassRepNodeMapping::Spatialize_Static || Policy == EClassRepNodeMapping::Spatialize_Dynamic || Policy == EClassRepNodeMapping::Spatialize_Dormancy || Policy == EClassRepNodeMapping::Equipment;
+		FClassReplicationInfo ClassInfo;
+		InitClassReplicationInfo(ClassInfo, Class, Spatialize, ServerMaxTickRate);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+void UFortniteCloneReplicationGraph::InitGlobalGraphNodes() {
+	// preallocate some replication lists
+	PreAllocateRepList(3, 12);
+	PreAllocateRepList(6, 12);
+	PreAllocateRepList(128, 64);
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = FVector2D(SpatialBiasX, SpatialBiasY);
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UFortniteCloneReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) {
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+	UFortniteCloneReplicationGraphNode_ForConnection* ForConnectionNode = CreateNewNode<UFortniteCloneReplicationGraphNode_ForConnection>();
+	AddConnectionGraphNode(ForConnectionNode, RepGraphConnection);
+}
+
+void UFortniteCloneReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) {
+	switch (GetMappingPolicy(ActorInfo.Class)) {
+	case EClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	case EClassRepNodeMapping::Equipment:
+		RouteEquipment(ActorInfo.Actor);
+		break;
+	default:
+		break;
+	}
+}
+
+void UFortniteCloneReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) {
+	switch (GetMappingPolicy(ActorInfo.Class)) {
+	case EClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	case EClassRepNodeMapping::Equipment:
+		if (SpatializedEquipment.Remove(ActorInfo.Actor) > 0) {
+			GridNode->RemoveActor_Dynamic(ActorInfo);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+UFortniteCloneReplicationGraph* UFortniteCloneReplicationGraph::Get(const UWorld* World) {
+	UNetDriver* Driver = World ? World->GetNetDriver() : nullptr;
+	return Driver ? Driver->GetReplicationDriver<UFortniteCloneReplicationGraph>() : nullptr;
+}
+
+void UFortniteCloneReplicationGraph::RouteEquipment(AActor* Item) {
+	if (Item == nullptr || GridNode == nullptr) {
+		return;
+	}
+	AWeaponActor* Weapon = Cast<AWeaponActor>(Item);
+	AHealingActor* HealingItem = Cast<AHealingActor>(Item);
+	const bool Held = (Weapon && Weapon->Holder) || (HealingItem && HealingItem->Holder);
+	if (!Held && !SpatializedEquipment.Contains(Item)) {
+		// dropped items barely move, but they are few and get picked up again, so they stay dynamic
+		SpatializedEquipment.Add(Item);
+		GridNode->AddActor_Dynamic(FNewReplicatedActorInfo(Item), GlobalActorReplicationInfoMap.Get(Item));
+	}
+	else if (Held && SpatializedEquipment.Remove(Item) > 0) {
+		GridNode->RemoveActor_Dynamic(FNewReplicatedActorInfo(Item));
+	}
+}
+
+void UFortniteCloneReplicationGraph::UpdateHeldEquipment(AFortniteCloneCharacter* Character) {
+	if (Character == nullptr) {
+		return;
+	}
+	for (AWeaponActor* Weapon : Character->WeaponPool) {
+		RouteEquipment(Weapon);
+	}
+	RouteEquipment(Character->HealingItemPool);
+	// everyone who gets the character sees what is in its hands, the stowed rest is gathered by the owner's connection node
+	FGlobalActorReplicationInfo& CharacterInfo = GlobalActorReplicationInfoMap.Get(Character);
+	CharacterInfo.DependentActorList.PrepareForWrite();
+	CharacterInfo.DependentActorList.Reset();
+	CharacterInfo.DependentActorList.ConditionalAdd(Character->CurrentWeapon);
+	CharacterInfo.DependentActorList.ConditionalAdd(Character->CurrentHealingItem);
+}
+
+void UFortniteCloneReplicationGraph::SetUpdateFrequency(AActor* Actor, float NetUpdateFrequency) {
+	if (Actor == nullptr || NetUpdateFrequency <= 0) {
+		return;
+	}
+	FGlobalActorReplicationInfo& ActorInfo = GlobalActorReplicationInfoMap.Get(Actor);
+	ActorInfo.Settings.ReplicationPeriodFrame = FMath::Max<uint32>((uint32)FMath::RoundToFloat(NetDriver->NetServerMaxTickRate / NetUpdateFrequency), 1);
+}
+
+EClassRepNodeMapping UFortniteCloneReplicationGraph::GetMappingPolicy(UClass* Class) {
+	EClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class);
+	if (Policy) {
+		return *Policy;
+	}
+	// classes the game doesn't know about are routed by their legacy relevancy flags
+	EClassRepNodeMapping Mapping = EClassRepNodeMapping::Spatialize_Dynamic;
+	AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+	if (ActorCDO && ActorCDO->bAlwaysRelevant) {
+		Mapping = EClassRepNodeMapping::RelevantAllConnections;
+	}
+	else if (ActorCDO && ActorCDO->bOnlyRelevantToOwner) {
+		Mapping = EClassRepNodeMapping::NotRouted;
+	}
+	ClassRepNodePolicies.Set(Class, Mapping);
+	return Mapping;
+}
+
+void UFortniteCloneReplicationGraph::InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool Spatialize, float ServerMaxTickRate) const {
+	AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+	if (Spatialize) {
+		Info.CullDistanceSquared = ActorCDO->NetCullDistanceSquared;
+	}
+	Info.ReplicationPeriodFrame = FMath::Max<uint32>((uint32)FMath::RoundToFloat(ServerMaxTickRate / ActorCDO->NetUpdateFrequency), 1);
+}
+
+void UFortniteCloneReplicationGraphNode_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) {
+	ReplicationActorList.Reset();
+	ReplicationActorList.ConditionalAdd(Params.Viewer.InViewer);
+	ReplicationActorList.ConditionalAdd(Params.Viewer.ViewTarget);
+	// the stowed pool belongs to the pawn this connection controls, a spectator's view target keeps its own
+	APlayerController* PlayerController = Params.ConnectionManager.NetConnection ? Params.ConnectionManager.NetConnection->PlayerController : nullptr;
+	AFortniteCloneCharacter* FortniteCloneCharacter = PlayerController ? Cast<AFortniteCloneCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (FortniteCloneCharacter) {
+		// the item in hand already replicates as a dependent of the character
+		for (AWeaponActor* Weapon : FortniteCloneCharacter->WeaponPool) {
+			if (Weapon != FortniteCloneCharacter->CurrentWeapon) {
+				ReplicationActorList.ConditionalAdd(Weapon);
+			}
+		}
+		if (FortniteCloneCharacter->HealingItemPool != FortniteCloneCharacter->CurrentHealingItem) {
+			ReplicationActorList.ConditionalAdd(FortniteCloneCharacter->HealingItemPool);
+		}
+	}
+	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
+}
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HUDViewModel.h"
+#include "FortniteClone.h"
+#include "FortniteCloneHUD.h"
+#include "FortniteCloneCharacter.h"
+#include "FortniteClonePlayerState.h"
+#include "InventoryComponent.h"
+#include "FortniteCloneAssetManager.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD View Model Update"), STAT_HUDViewModelUpdate, STATGROUP_FortniteClone);
+
+UHUDViewModel::UHUDViewModel()
+{
+	Health = 100;
+	for (int i = 0; i < 3; i++) {
+		MaterialCounts[i] = 0;
+	}
+	// the class default object is built before the asset manager has loaded the weapon table
+	if (!HasAnyFlags(RF_ClassDefaultObject)) {
+		AmmunitionCounts.SetNumZeroed(UFortniteCloneAssetManager::Get().GetWeaponCount());
+		ClipCounts.SetNumZeroed(AmmunitionCounts.Num());
+	}
+	BandageCount = 0;
+	KillCount = 0;
+}
+
+UHUDViewModel* UHUDViewModel::Get(APlayerController* PlayerController) {
+	if (PlayerController == nullptr || !PlayerController->IsLocalController()) {
+		return nullptr;
+	}
+	AFortniteCloneHUD* FortniteCloneHUD = Cast<AFortniteCloneHUD>(PlayerController->GetHUD());
+	return FortniteCloneHUD ? FortniteCloneHUD->ViewModel : nullptr;
+}
+
+void UHUDViewModel::Refresh(AFortniteCloneCharacter* Character, AFortniteClonePlayerState* State) {
+	if (Character) {
+		SetHealth(Character->Health);
+	}
+	if (State) {
+		for (int i = 0; i < 3; i++) {
+			SetMaterialCount(i, State->Inventory->GetCount(EInventoryItem::Material, i));
+		}
+		for (int i = 1; i < AmmunitionCounts.Num(); i++) {
+			SetAmmunitionCount(i, State->Inventory->GetCount(EInventoryItem::Ammunition, i));
+			SetClipCount(i, State->Inventory->GetCount(EInventoryItem::Clip, i));
+		}
+		SetBandageCount(State->Inventory->GetCount(EInventoryItem::Bandage, 0));
+		SetKillCount(State->KillCount);
+	}
+}
+
+void UHUDViewModel::SetHealth(float NewHealth) {
+	SCOPE_CYCLE_COUNTER(STAT_HUDViewModelUpdate);
+	if (Health != NewHealth) {
+		Health = NewHealth;
+		OnHealthChanged.Broadcast(Health);
+	}
+}
+
+void UHUDViewModel::SetMaterialCount(int MaterialType, int Count) {
+	SCOPE_CYCLE_COUNTER(STAT_HUDViewModelUpdate);
+	if (MaterialType >= 0 && MaterialType < 3 && MaterialCounts[MaterialType] != Count) {
+		MaterialCounts[MaterialType] = Count;
+		OnMaterialCountChanged.Broadcast(MaterialType, Count);
+	}
+}
+
+void UHUDViewModel::SetAmmunitionCount(int WeaponType, int Count) {
+	SCOPE_CYCLE_COUNTER(STAT_HUDViewModelUpdate);
+	if (AmmunitionCounts.IsValidIndex(WeaponType) && AmmunitionCounts[WeaponType] != Count) {
+		AmmunitionCounts[WeaponType] = Count;
+		OnAmmunitionCountChanged.Broadcast(WeaponType, GetAmmunitionCount(WeaponType));
+	}
+}
+
+void UHUDViewModel::SetClipCount(int WeaponType, int Count) {
+	SCOPE_CYCLE_COUNTER(STAT_HUDViewModelUpdate);
+	if (ClipCounts.IsValidIndex(WeaponType) && ClipCounts[WeaponType] != Count) {
+		ClipCounts[WeaponType] = Count;
+		OnAmmunitionCountChanged.Broadcast(WeaponType, GetAmmunitionCount(WeaponType));
+	}
+}
+
+void UHUDViewModel::SetBandageCount(int Count) {
+	SCOPE_CYCLE_COUNTER(STAT_HUDViewModelUpdate);
+	if (BandageCount != Count) {
+		BandageCount = Count;
+		OnBandageCountChanged.Broadcast(BandageCount);
+	}
+}
+
+void UHUDViewModel::SetKillCount(int Count) {
+	SCOPE_CYCLE_COUNTER(STAT_HUDViewModelUpdate);
+	if (KillCount != Count) {
+		KillCount = Count;
+		OnKillCountChanged.Broadcast(KillCount);
+	}
+}
+
+float UHUDViewModel::GetHealth() const {
+	return Health;
+}
+
+int UHUDViewModel::GetMaterialCount(int MaterialType) const {
+	return (MaterialType >= 0 && MaterialType < 3) ? MaterialCounts[MaterialType] : 0;
+}
+
+int UHUDViewModel::GetAmmunitionCount(int WeaponType) const {
+	return AmmunitionCounts.IsValidIndex(WeaponType) ? AmmunitionCounts[WeaponType] + ClipCounts[WeaponType] : 0;
+}
+
+int UHUDViewModel::GetWeaponCount() const {
+	return AmmunitionCounts.Num();
+}
+
+int UHUDViewModel::GetBandageCount() const {
+	return BandageCount;
+}
+
+int UHUDViewModel::GetKillCount() const {
+	return KillCount;
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HUDWidget.h"
+#include "HUDViewModel.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+void UHUDWidget::NativeConstruct() {
+	Super::NativeConstruct();
+	// the HUD creates its widgets from the world, so the owning player can be unset
+	APlayerController* PlayerController = GetOwningPlayer() ? GetOwningPlayer() : GetWorld()->GetFirstPlayerController();
+	ViewModel = UHUDViewModel::Get(PlayerController);
+	if (ViewModel == nullptr) {
+		return;
+	}
+	ViewModel->OnHealthChanged.AddDynamic(this, &UHUDWidget::HandleHealthChanged);
+	ViewModel->OnMaterialCountChanged.AddDynamic(this, &UHUDWidget::HandleMaterialCountChanged);
+	ViewModel->OnAmmunitionCountChanged.AddDynamic(this, &UHUDWidget::HandleAmmunitionCountChanged);
+	ViewModel->OnBandageCountChanged.AddDynamic(this, &UHUDWidget::HandleBandageCountChanged);
+	ViewModel->OnKillCountChanged.AddDynamic(this, &UHUDWidget::HandleKillCountChanged);
+	// values that replicated before the widget existed are shown once
+	OnHealthChanged(ViewModel->GetHealth());
+	for (int i = 0; i < 3; i++) {
+		OnMaterialCountChanged(i, ViewModel->GetMaterialCount(i));
+	}
+	// the pickaxe never has ammunition
+	for (int i = 1; i < ViewModel->GetWeaponCount(); i++) {
+		OnAmmunitionCountChanged(i, ViewModel->GetAmmunitionCount(i));
+	}
+	OnBandageCountChanged(ViewModel->GetBandageCount());
+	OnKillCountChanged(ViewModel->GetKillCount());
+}
+
+void UHUDWidget::NativeDestruct() {
+	if (ViewModel) {
+		ViewModel->OnHealthChanged.RemoveAll(this);
+		ViewModel->OnMaterialCountChanged.RemoveAll(this);
+		ViewModel->OnAmmunitionCountChanged.RemoveAll(this);
+		ViewModel->OnBandageCountChanged.RemoveAll(this);
+		ViewModel->OnKillCountChanged.RemoveAll(this);
+		ViewModel = nullptr;
+	}
+	Super::NativeDestruct();
+}
+
+void UHUDWidget::HandleHealthChanged(float Value) {
+	OnHealthChanged(Value);
+}
+
+void UHUDWidget::HandleMaterialCountChanged(int Index, int Count) {
+	OnMaterialCountChanged(Index, Count);
+}
+
+void UHUDWidget::HandleAmmunitionCountChanged(int Index, int Count) {
+	OnAmmunitionCountChanged(Index, Count);
+}
+
+void UHUDWidget::HandleBandageCountChanged(int Count) {
+	OnBandageCountChanged(Count);
+}
+
+void UHUDWidget::HandleKillCountChanged(int Count) {
+	OnKillCountChanged(Count);
+}
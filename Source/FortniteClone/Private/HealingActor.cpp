@@ -8,6 +8,8 @@ AHealingActor::AHealingActor()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// floor loot stays dormant until it is picked up, held bandages are woken up by their holder
+	NetDormancy = DORM_Initial;
 
 }
 
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "InventoryComponent.h"
+#include "UnrealNetwork.h"
+#include "HUDViewModel.h"
+#include "GameFramework/PlayerController.h"
+
+// Sets default values for this component's properties
+UInventoryComponent::UInventoryComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicated(true);
+	Items.Owner = this;
+}
+
+// Called when the game starts
+void UInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	if (GetOwnerRole() == ROLE_Authority) {
+		SetCount(EInventoryItem::Weapon, 0, 1); // everyone starts with a pickaxe
+	}
+}
+
+void UInventoryComponent::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(UInventoryComponent, Items, COND_OwnerOnly);
+}
+
+int UInventoryComponent::GetCount(EInventoryItem Item, int Index) const {
+	const FInventoryEntry* Entry = FindEntry(Item, Index);
+	return Entry ? Entry->Count : 0;
+}
+
+void UInventoryComponent::SetCount(EInventoryItem Item, int Index, int Count) {
+	FInventoryEntry* Entry = FindEntry(Item, Index);
+	if (Entry == nullptr) {
+		// the inventory only holds entries for things the player has had, there are at most a dozen
+		int NewIndex = Items.Entries.AddDefaulted();
+		Entry = &Items.Entries[NewIndex];
+		Entry->Item = Item;
+		Entry->Index = (uint8)Index;
+	}
+	else if (Entry->Count == Count) {
+		return;
+	}
+	Entry->Count = Count;
+	Items.MarkItemDirty(*Entry);
+	NotifyEntryChanged(*Entry);
+}
+
+void UInventoryComponent::AddCount(EInventoryItem Item, int Index, int Delta) {
+	SetCount(Item, Index, GetCount(Item, Index) + Delta);
+}
+
+bool UInventoryComponent::HasWeapon(int WeaponType) const {
+	return GetCount(EInventoryItem::Weapon, WeaponType) > 0;
+}
+
+void UInventoryComponent::NotifyEntryChanged(const FInventoryEntry& Entry) {
+	// the component lives on the player state, which is owned by the player controller
+	UHUDViewModel* ViewModel = UHUDViewModel::Get(Cast<APlayerController>(GetOwner() ? GetOwner()->GetOwner() : nullptr));
+	if (ViewModel == nullptr) {
+		return;
+	}
+	switch (Entry.Item) {
+	case EInventoryItem::Material:
+		ViewModel->SetMaterialCount(Entry.Index, Entry.Count);
+		break;
+	case EInventoryItem::Ammunition:
+		ViewModel->SetAmmunitionCount(Entry.Index, Entry.Count);
+		break;
+	case EInventoryItem::Clip:
+		ViewModel->SetClipCount(Entry.Index, Entry.Count);
+		break;
+	case EInventoryItem::Bandage:
+		ViewModel->SetBandageCount(Entry.Count);
+		break;
+	default:
+		break;
+	}
+}
+
+FInventoryEntry* UInventoryComponent::FindEntry(EInventoryItem Item, int Index) {
+	for (int i = 0; i < Items.Entries.Num(); i++) {
+		if (Items.Entries[i].Item == Item && Items.Entries[i].Index == Index) {
+			return &Items.Entries[i];
+		}
+	}
+	return nullptr;
+}
+
+const FInventoryEntry* UInventoryComponent::FindEntry(EInventoryItem Item, int Index) const {
+	return const_cast<UInventoryComponent*>(this)->FindEntry(Item, Index);
+}
+
+void FInventoryEntry::PostReplicatedAdd(const FInventoryList& InArraySerializer) {
+	if (InArraySerializer.Owner) {
+		InArraySerializer.Owner->NotifyEntryChanged(*this);
+	}
+}
+
+void FInventoryEntry::PostReplicatedChange(const FInventoryList& InArraySerializer) {
+	if (InArraySerializer.Owner) {
+		InArraySerializer.Owner->NotifyEntryChanged(*this);
+	}
+}
@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MatchEventLog.h"
+#include "FortniteClone.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Match Events Recorded"), STAT_MatchEventsRecorded, STATGROUP_FortniteClone);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Match Events Dropped"), STAT_MatchEventsDropped, STATGROUP_FortniteClone);
+
+namespace
+{
+	/* Start of every log file, the record size lets a decoder reject a file written by a different layout */
+	struct FMatchEventLogHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint16 RecordSize;
+	};
+
+	const uint32 LogMagic = 0x4C564546; // "FEVL"
+	const uint16 LogVersion = 1;
+
+	const TCHAR* EventNames[] = {
+		TEXT("Kill"),
+		TEXT("Damage"),
+		TEXT("Build"),
+		TEXT("Pickup"),
+		TEXT("StormPhase"),
+		TEXT("Spectate")
+	};
+	static_assert(ARRAY_COUNT(EventNames) == (int)EMatchEvent::Count, "every match event needs a name");
+}
+
+class FMatchEventLog::FWriter : public FRunnable
+{
+public:
+	FWriter(FMatchEventLog& InLog)
+		: Log(InLog)
+	{
+	}
+
+	virtual uint32 Run() override {
+		while (!StopRequested) {
+			Log.Drain();
+			FPlatformProcess::Sleep(Log.FlushInterval);
+		}
+		// whatever was recorded before Stop was called
+		Log.Drain();
+		return 0;
+	}
+
+	virtual void Stop() override {
+		StopRequested = true;
+	}
+
+private:
+	FMatchEventLog& Log;
+
+	FThreadSafeBool StopRequested;
+};
+
+FMatchEventLog::FEventRing::FEventRing()
+	: Head(0)
+	, Tail(0)
+{
+}
+
+FMatchEventLog::FMatchEventLog()
+{
+	FlushInterval = 0.5f;
+	RingSlot = FPlatformTLS::AllocTlsSlot();
+	File = nullptr;
+	Writer = nullptr;
+	WriterThread = nullptr;
+	StartTime = 0;
+}
+
+FMatchEventLog& FMatchEventLog::Get() {
+	static FMatchEventLog Log;
+	return Log;
+}
+
+bool FMatchEventLog::Start(const FString& Path) {
+	if (Running) {
+		return true;
+	}
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+	File = PlatformFile.OpenWrite(*Path);
+	if (File == nullptr) {
+		return false;
+	}
+	FMatchEventLogHeader Header;
+	Header.Magic = LogMagic;
+	Header.Version = LogVersion;
+	Header.RecordSize = sizeof(FMatchEventRecord);
+	File->Write((const uint8*)&Header, sizeof(Header));
+	{
+		// events left over from a previous match are thrown away, nothing is draining yet so moving the tails is safe
+		FScopeLock Lock(&RingsLock);
+		for (int i = 0; i < Rings.Num(); i++) {
+			Rings[i]->Tail = (uint32)Rings[i]->Head;
+		}
+	}
+	StartTime = FPlatformTime::Seconds();
+	Running = true;
+	Writer = new FWriter(*this);
+	WriterThread = FRunnableThread::Create(Writer, TEXT("MatchEventLogWriter"), 0, TPri_BelowNormal);
+	return true;
+}
+
+void FMatchEventLog::Stop() {
+	if (!Running) {
+		return;
+	}
+	Running = false;
+	// Kill waits for the writer's final drain
+	WriterThread->Kill(true);
+	delete WriterThread;
+	WriterThread = nullptr;
+	delete Writer;
+	Writer = nullptr;
+	delete File;
+	File = nullptr;
+}
+
+bool FMatchEventLog::IsRunning() const {
+	return Running;
+}
+
+void FMatchEventLog::Record(EMatchEvent Type, uint8 Kind, uint8 Variant, int32 Subject, int32 Object, float Value, const FVector& Location) {
+	if (!Running) {
+		return;
+	}
+	FEventRing* Ring = GetThreadRing();
+	const uint32 Head = Ring->Head;
+	if (Head - (uint32)Ring->Tail >= FEventRing::Capacity) {
+		// the writer is behind, losing an event is better than stalling the game thread
+		INC_DWORD_STAT(STAT_MatchEventsDropped);
+		return;
+	}
+	FMatchEventRecord& Event = Ring->Records[Head % FEventRing::Capacity];
+	Event.Time = (float)(FPlatformTime::Seconds() - StartTime);
+	Event.Type = Type;
+	Event.Kind = Kind;
+	Event.Variant = Variant;
+	Event.Padding = 0;
+	Event.Subject = Subject;
+	Event.Object = Object;
+	Event.Value = Value;
+	Event.X = Location.X;
+	Event.Y = Location.Y;
+	Event.Z = Location.Z;
+	// publishing the new head after the record is written lets the writer read it without a lock
+	Ring->Head = Head + 1;
+	INC_DWORD_STAT(STAT_MatchEventsRecorded);
+}
+
+int32 FMatchEventLog::GetPlayerId(const APawn* Pawn) {
+	return Pawn && Pawn->PlayerState ? Pawn->PlayerState->PlayerId : -1;
+}
+
+FMatchEventLog::FEventRing* FMatchEventLog::GetThreadRing() {
+	FEventRing* Ring = (FEventRing*)FPlatformTLS::GetTlsValue(RingSlot);
+	if (Ring == nullptr) {
+		Ring = new FEventRing();
+		FPlatformTLS::SetTlsValue(RingSlot, Ring);
+		FScopeLock Lock(&RingsLock);
+		Rings.Emplace(Ring);
+	}
+	return Ring;
+}
+
+void FMatchEventLog::Drain() {
+	Batch.Reset();
+	{
+		FScopeLock Lock(&RingsLock);
+		for (int i = 0; i < Rings.Num(); i++) {
+			FEventRing* Ring = Rings[i].Get();
+			const uint32 Head = Ring->Head;
+			uint32 Tail = Ring->Tail;
+			for (; Tail != Head; Tail++) {
+				Batch.Add(Ring->Records[Tail % FEventRing::Capacity]);
+			}
+			Ring->Tail = Tail;
+		}
+	}
+	if (Batch.Num() > 0 && File) {
+		File->Write((const uint8*)Batch.GetData(), Batch.Num() * sizeof(FMatchEventRecord));
+		File->Flush();
+	}
+}
+
+bool FMatchEventLog::DecodeToCsv(const FString& LogPath, const FString& CsvPath) {
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *LogPath) || Bytes.Num() < (int)sizeof(FMatchEventLogHeader)) {
+		return false;
+	}
+	const FMatchEventLogHeader* Header = (const FMatchEventLogHeader*)Bytes.GetData();
+	if (Header->Magic != LogMagic || Header->Version != LogVersion || Header->RecordSize != sizeof(FMatchEventRecord)) {
+		return false;
+	}
+	const int Count = (Bytes.Num() - sizeof(FMatchEventLogHeader)) / sizeof(FMatchEventRecord);
+	TArray<FMatchEventRecord> Events;
+	Events.AddUninitialized(Count);
+	FMemory::Memcpy(Events.GetData(), Bytes.GetData() + sizeof(FMatchEventLogHeader), Count * sizeof(FMatchEventRecord));
+	// each thread's ring is written in order, but rings are interleaved in the file
+	Events.StableSort([](const FMatchEventRecord& A, const FMatchEventRecord& B) { return A.Time < B.Time; });
+	FString Csv = TEXT("Time,Event,Kind,Variant,Subject,Object,Value,X,Y,Z\n");
+	for (const FMatchEventRecord& Event : Events) {
+		const TCHAR* Name = (int)Event.Type < (int)EMatchEvent::Count ? EventNames[(int)Event.Type] : TEXT("Unknown");
+		Csv += FString::Printf(TEXT("%.3f,%s,%d,%d,%d,%d,%.2f,%.1f,%.1f,%.1f\n"), Event.Time, Name, Event.Kind, Event.Variant, Event.Subject, Event.Object, Event.Value, Event.X, Event.Y, Event.Z);
+	}
+	return FFileHelper::SaveStringToFile(Csv, *CsvPath);
+}
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MatchEventLogCommandlet.h"
+#include "FortniteCloneGameMode.h"
+#include "MatchEventLog.h"
+#include "Misc/Paths.h"
+
+UMatchEventLogCommandlet::UMatchEventLogCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMatchEventLogCommandlet::Main(const FString& Params) {
+	FString LogPath;
+	if (!FParse::Value(*Params, TEXT("in="), LogPath)) {
+		UE_LOG(LogMyServer, Error, TEXT("Usage: -run=MatchEventLog -in=<Events.fcevents> [-out=<Events.csv>]"));
+		return 1;
+	}
+	FString CsvPath;
+	if (!FParse::Value(*Params, TEXT("out="), CsvPath)) {
+		CsvPath = FPaths::ChangeExtension(LogPath, TEXT("csv"));
+	}
+	if (!FMatchEventLog::DecodeToCsv(LogPath, CsvPath)) {
+		UE_LOG(LogMyServer, Error, TEXT("Could not decode %s to %s"), *LogPath, *CsvPath);
+		return 1;
+	}
+	UE_LOG(LogMyServer, Display, TEXT("Decoded %s to %s"), *LogPath, *CsvPath);
+	return 0;
+}
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MatchProfiler.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	const TCHAR* ScopeNames[] = {
+		TEXT("CharacterTick"),
+		TEXT("FireWeapons"),
+		TEXT("BuildStructures"),
+		TEXT("CharacterOverlap"),
+		TEXT("ProjectileOverlap"),
+		TEXT("ProjectileSimulation"),
+		TEXT("StormDamage"),
+		TEXT("StormTick")
+	};
+	static_assert(ARRAY_COUNT(ScopeNames) == (int)EProfiledScope::Count, "every profiled scope needs a name");
+
+	float Percentile(const TArray<float>& Sorted, float Fraction) {
+		// nearest rank on an already sorted array
+		const int Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	void AppendRow(FString& Csv, const TCHAR* Name, const TArray<float>& Values) {
+		if (Values.Num() == 0) {
+			return;
+		}
+		TArray<float> Sorted = Values;
+		Sorted.Sort();
+		double Sum = 0;
+		for (int i = 0; i < Sorted.Num(); i++) {
+			Sum += Sorted[i];
+		}
+		Csv += FString::Printf(TEXT("%s,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n"), Name, Sum / Sorted.Num(), Percentile(Sorted, 0.5f), Percentile(Sorted, 0.95f), Percentile(Sorted, 0.99f), Sorted.Last(), Sum);
+	}
+}
+
+FMatchProfiler::FScope::FScope(EProfiledScope InScope)
+	: Scope(InScope)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FMatchProfiler::FScope::~FScope()
+{
+	FMatchProfiler::Get().AddScopeTime(Scope, FPlatformTime::Seconds() - StartTime);
+}
+
+FMatchProfiler::FMatchProfiler()
+{
+	Reset();
+}
+
+FMatchProfiler& FMatchProfiler::Get() {
+	static FMatchProfiler Profiler;
+	return Profiler;
+}
+
+void FMatchProfiler::Reset() {
+	FrameTimes.Reset();
+	for (int i = 0; i < ScopeCount; i++) {
+		ScopeTimes[i].Reset();
+		CurrentScopeSeconds[i] = 0;
+	}
+	Spawns.Reset();
+	Destroys.Reset();
+	CurrentSpawns = 0;
+	CurrentDestroys = 0;
+	FrameStartTime = 0;
+}
+
+void FMatchProfiler::AddScopeTime(EProfiledScope Scope, double Seconds) {
+	CurrentScopeSeconds[(int)Scope] += Seconds;
+}
+
+void FMatchProfiler::CountSpawn() {
+	CurrentSpawns++;
+}
+
+void FMatchProfiler::CountDestroy() {
+	CurrentDestroys++;
+}
+
+void FMatchProfiler::BeginFrame() {
+	FrameStartTime = FPlatformTime::Seconds();
+}
+
+void FMatchProfiler::EndFrame() {
+	if (FrameStartTime <= 0) {
+		return;
+	}
+	// the delta time includes the sleep that holds the server to its tick rate, the idle time of this frame is taken back out
+	const double GameThreadSeconds = FMath::Max(FPlatformTime::Seconds() - FrameStartTime - FApp::GetIdleTime(), 0.0);
+	FrameTimes.Add((float)(GameThreadSeconds * 1000.0));
+	for (int i = 0; i < ScopeCount; i++) {
+		ScopeTimes[i].Add((float)(CurrentScopeSeconds[i] * 1000.0));
+		CurrentScopeSeconds[i] = 0;
+	}
+	Spawns.Add((float)CurrentSpawns);
+	Destroys.Add((float)CurrentDestroys);
+	CurrentSpawns = 0;
+	CurrentDestroys = 0;
+}
+
+bool FMatchProfiler::WriteCsv(const FString& Path) const {
+	// times are in milliseconds per frame, spawns and destroys are actors per frame
+	FString Csv = FString::Printf(TEXT("Metric,Mean,P50,P95,P99,Max,Total\n"));
+	AppendRow(Csv, TEXT("GameThreadTime"), FrameTimes);
+	for (int i = 0; i < ScopeCount; i++) {
+		AppendRow(Csv, ScopeNames[i], ScopeTimes[i]);
+	}
+	AppendRow(Csv, TEXT("ActorsSpawned"), Spawns);
+	AppendRow(Csv, TEXT("ActorsDestroyed"), Destroys);
+	Csv += FString::Printf(TEXT("Frames,%d,,,,,\n"), FrameTimes.Num());
+	return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+bool FMatchProfiler::IsEmpty() const {
+	return FrameTimes.Num() == 0;
+}
@@ -8,6 +8,8 @@ AMaterialActor::AMaterialActor()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// harvestables placed in the map are only woken up when they are hit
+	NetDormancy = DORM_Initial;
 
 }
 
@@ -12,6 +12,13 @@
 #include "UnrealNetwork.h"
 #include "StormActor.h"
 #include "FortniteClonePlayerController.h"
+#include "FortniteCloneGameMode.h"
+#include "InventoryComponent.h"
+#include "FortniteClone.h"
+#include "MatchProfiler.h"
+#include "WeaponDefinition.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Overlap"), STAT_ProjectileOverlap, STATGROUP_FortniteClone);
 
 // Sets default values
 AProjectileActor::AProjectileActor()
@@ -54,200 +61,104 @@ void AProjectileActor::Tick(float DeltaTime)
 }
 
 void AProjectileActor::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) {
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileOverlap);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::ProjectileOverlap);
 	if (HasAuthority()) {
-		if (OtherActor != nullptr) {
-			//bullet should only destroy itself once it overlaps with an actor other than itself, the weapon it came from, and the holder of that weapon
-			if ((Weapon && OtherActor == (AActor*)Weapon) || (WeaponHolder && OtherActor == (AActor*)WeaponHolder) || OtherActor == this) {
-				return;
-			}
-			else {
-				//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("NetMode: ") + FString::FromInt(GetNetMode()) + FString(" Collided Actor: ") + OtherActor->GetName());
-				if (OtherActor->IsA(AWeaponActor::StaticClass())) {
-					//if the weapon has no holder, then let the bullet keep going
-					AWeaponActor* WeaponActor = Cast<AWeaponActor>(OtherActor);
-					if (WeaponActor) {
-						if (WeaponActor->Holder == nullptr) {
-							return;
-						}
-						else {
-							AFortniteCloneCharacter* FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(WeaponActor->Holder);
-							if (FortniteCloneCharacter) {
-								FortniteCloneCharacter->Health -= Damage;
-								if (WeaponHolder) {
-									// draw hitmarker
-									WeaponHolder->ClientDrawHitMarker();
-								}
-								if (FortniteCloneCharacter->Health <= 0) {
-									if (WeaponActor) {
-										WeaponActor->Destroy();
-									}
-									if (FortniteCloneCharacter) {
-										if (FortniteCloneCharacter->BuildingPreview) {
-											FortniteCloneCharacter->BuildingPreview->Destroy();
-										}
-										if (FortniteCloneCharacter->CurrentHealingItem) {
-											FortniteCloneCharacter->CurrentHealingItem->Destroy();
-										}
-										AFortniteClonePlayerController* FortniteClonePlayerController = Cast<AFortniteClonePlayerController>(FortniteCloneCharacter->GetController());
-										if (FortniteClonePlayerController) {
-											FortniteClonePlayerController->ServerSwitchToSpectatorMode();
-										}
-										FortniteCloneCharacter->Destroy();
-									}
-									FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(WeaponHolder);
-									if (FortniteCloneCharacter) {
-										if (FortniteCloneCharacter->GetController() && FortniteCloneCharacter->GetController()->PlayerState) {
-											AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(FortniteCloneCharacter->GetController()->PlayerState);
-											if (State) {
-												State->KillCount++;
-											}
-										}
-									}
-								}
-							}
-							Destroy();
-						}
-					}
-				}
-				else if (OtherActor->IsA(AHealingActor::StaticClass())) {
-					//if the healing item has no holder, then let the bullet keep going
-					AHealingActor* HealingActor = Cast<AHealingActor>(OtherActor);
-					if (HealingActor) {
-						if (HealingActor->Holder == nullptr) {
-							return;
-						}
-						else {
-							AFortniteCloneCharacter* FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(HealingActor->Holder);
-							if (FortniteCloneCharacter) {
-								FortniteCloneCharacter->Health -= Damage;
-								if (WeaponHolder) {
-									// draw hitmarker
-									WeaponHolder->ClientDrawHitMarker();
-								}
-								if (FortniteCloneCharacter->Health <= 0) {
-									if (HealingActor) {
-										HealingActor->Destroy();
-									}
-									if (FortniteCloneCharacter) {
-										if (FortniteCloneCharacter->BuildingPreview) {
-											FortniteCloneCharacter->BuildingPreview->Destroy();
-										}
-										if (FortniteCloneCharacter->CurrentWeapon) {
-											FortniteCloneCharacter->CurrentHealingItem->Destroy();
-										}
-										AFortniteClonePlayerController* FortniteClonePlayerController = Cast<AFortniteClonePlayerController>(FortniteCloneCharacter->GetController());
-										if (FortniteClonePlayerController) {
-											FortniteClonePlayerController->ServerSwitchToSpectatorMode();
-										}
-										FortniteCloneCharacter->Destroy();
-									}
-									FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(WeaponHolder);
-									if (FortniteCloneCharacter) {
-										if (FortniteCloneCharacter->GetController() && FortniteCloneCharacter->GetController()->PlayerState) {
-											AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(FortniteCloneCharacter->GetController()->PlayerState);
-											if (State) {
-												State->KillCount++;
-											}
-										}
-									}
-								}
-							}
-							Destroy();
-						}
-					}
-				}
-				else if (OtherActor->IsA(ABuildingActor::StaticClass())) {
-					//make sure the buildingactor is not a preview, if it is a preview then let the bullet keep going
-					ABuildingActor* BuildingActor = Cast<ABuildingActor>(OtherActor);
-					if (BuildingActor->IsPreview) {
-						return;
-					}
-					else {
-						BuildingActor->Health -= Damage;
-						if (BuildingActor->Health <= 0) {
-							if (BuildingActor) {
-								BuildingActor->Destroy();
-							}
-						}
-						Destroy();
-					}
-				}
-				else if (OtherActor->IsA(AFortniteCloneCharacter::StaticClass())) {
-					AFortniteCloneCharacter* FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(OtherActor);
-					if (FortniteCloneCharacter) {
-						FortniteCloneCharacter->Health -= Damage;
-						if (WeaponHolder) {
-							// draw hitmarker
-							WeaponHolder->ClientDrawHitMarker();
-						}
-						if (FortniteCloneCharacter->Health <= 0) {
-							if (FortniteCloneCharacter && FortniteCloneCharacter->CurrentWeapon) {
-								FortniteCloneCharacter->CurrentWeapon->Destroy();
-							}
-							if (FortniteCloneCharacter && FortniteCloneCharacter->CurrentHealingItem) {
-								FortniteCloneCharacter->CurrentHealingItem->Destroy();
-							}
-							if (FortniteCloneCharacter && FortniteCloneCharacter->BuildingPreview) {
-								FortniteCloneCharacter->BuildingPreview->Destroy();
-							}
-							if (FortniteCloneCharacter) {
-								AFortniteClonePlayerController* FortniteClonePlayerController = Cast<AFortniteClonePlayerController>(FortniteCloneCharacter->GetController());
-								if (FortniteClonePlayerController) {
-									FortniteClonePlayerController->ServerSwitchToSpectatorMode();
-								}
-								FortniteCloneCharacter->Destroy();
-							}
-							FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(WeaponHolder);
-							if (FortniteCloneCharacter) {
-								if (FortniteCloneCharacter->GetController() && FortniteCloneCharacter->GetController()->PlayerState) {
-									AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(FortniteCloneCharacter->GetController()->PlayerState);
-									if (State) {
-										State->KillCount++;
-									}
-								}
-							}
-						}
-						Destroy();
-					}
-				}
-				else if (OtherActor->IsA(AProjectileActor::StaticClass())) {
-					//let the bullet keep going if it collides with other bullets
-					return;
-				}
-				else if (OtherActor->IsA(AStormActor::StaticClass())) {
-					//let the bullet keep going if it collides with the storm
-					return;
-				}
-				else if (OtherActor->IsA(AMaterialActor::StaticClass())) {
-					AMaterialActor* MaterialActor = Cast<AMaterialActor>(OtherActor);
-					if (MaterialActor) {
-						MaterialActor->Health -= Damage;
-						if (ProjectileType == 0) {
-							//increase the counts of the owner of the weapon that shot the projectile
-							if (WeaponHolder) {
-								AFortniteCloneCharacter* FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(WeaponHolder);
-								if (FortniteCloneCharacter && FortniteCloneCharacter->GetController() && FortniteCloneCharacter->GetController()->PlayerState) {
-									AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(FortniteCloneCharacter->GetController()->PlayerState);
-									if (State) {
-										State->MaterialCounts[MaterialActor->MaterialType] += MaterialActor->MaterialCount;
-									}
-								}
-							}
-						}
-						if (MaterialActor->Health <= 0) {
-							MaterialActor->Destroy();
-						}
-						Destroy();
-					}
-				}
-				else {
-					Destroy();
+		if (OtherActor == this) {
+			return;
+		}
+		if (ResolveHit(OtherActor, Damage, ProjectileType, WeaponHolder, Weapon)) {
+			Destroy();
+		}
+	}
+}
+
+bool AProjectileActor::ResolveHit(AActor* OtherActor, float Damage, int ProjectileType, AFortniteCloneCharacter* WeaponHolder, AWeaponActor* Weapon, bool bBlockingHit) {
+	if (OtherActor == nullptr) {
+		// hit world geometry without an owning actor
+		return true;
+	}
+	//bullet should only destroy itself once it overlaps with an actor other than itself, the weapon it came from, and the holder of that weapon
+	if ((Weapon && OtherActor == (AActor*)Weapon) || (WeaponHolder && OtherActor == (AActor*)WeaponHolder)) {
+		return false;
+	}
+	if (OtherActor->IsA(AWeaponActor::StaticClass())) {
+		//let the bullet keep going, a holder is only hit through its own capsule so lag compensation applies
+		return false;
+	}
+	else if (OtherActor->IsA(AHealingActor::StaticClass())) {
+		//let the bullet keep going, same as weapons
+		return false;
+	}
+	else if (OtherActor->IsA(ABuildingActor::StaticClass())) {
+		//make sure the buildingactor is not a preview, if it is a preview then let the bullet keep going
+		ABuildingActor* BuildingActor = Cast<ABuildingActor>(OtherActor);
+		if (BuildingActor->IsPreview) {
+			return false;
+		}
+		// wake the piece up so the new health replicates, it goes back to sleep once that has been sent
+		BuildingActor->FlushNetDormancy();
+		BuildingActor->Health -= Damage;
+		if (BuildingActor->Health <= 0) {
+			BuildingActor->Destroy();
+		}
+		return true;
+	}
+	else if (OtherActor->IsA(AFortniteCloneCharacter::StaticClass())) {
+		DamageCharacter(Cast<AFortniteCloneCharacter>(OtherActor), Damage, WeaponHolder);
+		return true;
+	}
+	else if (OtherActor->IsA(AProjectileActor::StaticClass())) {
+		//let the bullet keep going if it collides with other bullets
+		return false;
+	}
+	else if (OtherActor->IsA(AStormActor::StaticClass())) {
+		//let the bullet keep going if it collides with the storm
+		return false;
+	}
+	else if (OtherActor->IsA(AMaterialActor::StaticClass())) {
+		AMaterialActor* MaterialActor = Cast<AMaterialActor>(OtherActor);
+		MaterialActor->FlushNetDormancy();
+		MaterialActor->Health -= Damage;
+		if (ProjectileType == 0) {
+			//increase the counts of the owner of the weapon that shot the projectile
+			if (WeaponHolder && WeaponHolder->GetController() && WeaponHolder->GetController()->PlayerState) {
+				AFortniteClonePlayerState* State = Cast<AFortniteClonePlayerState>(WeaponHolder->GetController()->PlayerState);
+				if (State) {
+					State->Inventory->AddCount(EInventoryItem::Material, MaterialActor->MaterialType, MaterialActor->MaterialCount);
 				}
 			}
 		}
+		if (MaterialActor->Health <= 0) {
+			MaterialActor->Destroy();
+		}
+		return true;
+	}
+	//let the bullet pass through anything else it only overlaps, like pickups and triggers
+	return bBlockingHit;
+}
+
+float AProjectileActor::GetProjectileSpeed(TSubclassOf<AProjectileActor> BulletClass, const UWeaponDefinition* Definition) {
+	if (Definition && Definition->ProjectileSpeed > 0) {
+		return Definition->ProjectileSpeed;
+	}
+	// the bullet blueprints set their speed on the movement component, fall back to the projectile speed property
+	const AProjectileActor* BulletDefaults = BulletClass->GetDefaultObject<AProjectileActor>();
+	if (BulletDefaults->ProjectileMovementComponent && BulletDefaults->ProjectileMovementComponent->InitialSpeed > 0) {
+		return BulletDefaults->ProjectileMovementComponent->InitialSpeed;
+	}
+	return BulletDefaults->ProjectileSpeed;
+}
+
+void AProjectileActor::DamageCharacter(AFortniteCloneCharacter* FortniteCloneCharacter, float Damage, AFortniteCloneCharacter* WeaponHolder) {
+	if (FortniteCloneCharacter == nullptr) {
+		return;
+	}
+	// damage and deaths are applied by the game mode once per frame
+	AFortniteCloneGameMode* GameMode = FortniteCloneCharacter->GetWorld()->GetAuthGameMode<AFortniteCloneGameMode>();
+	if (GameMode) {
+		GameMode->QueueDamage(FortniteCloneCharacter, Damage, WeaponHolder);
 	}
-	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, OtherActor->GetName());
-	//GetWorld()->DestroyActor(this);
 }
 
 void AProjectileActor::SelfDestruct() {
@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ProjectileManager.h"
+#include "Engine.h"
+#include "ProjectileActor.h"
+#include "WeaponActor.h"
+#include "HealingActor.h"
+#include "WeaponDefinition.h"
+#include "FortniteCloneCharacter.h"
+#include "EngineUtils.h"
+#include "FortniteClone.h"
+#include "MatchProfiler.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Simulation"), STAT_ProjectileSimulation, STATGROUP_FortniteClone);
+
+// Sets default values
+AProjectileManager::AProjectileManager()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bReplicates = false;
+	LiveProjectileCount = 0;
+	MaxRewindTime = 0.25f;
+}
+
+// Called every frame
+void AProjectileManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileSimulation);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::ProjectileSimulation);
+	ExpireProjectiles(GetWorld()->GetTimeSeconds());
+	if (LiveProjectileCount == 0) {
+		return;
+	}
+
+	// characters are tested against their rewound capsules instead of where they are now on the server
+	Characters.Reset();
+	FCollisionQueryParams QueryParams(FName(TEXT("ProjectileSweep")), false);
+	for (TActorIterator<AFortniteCloneCharacter> It(GetWorld()); It; ++It) {
+		if (!It->IsPendingKill()) {
+			Characters.Add(*It);
+			QueryParams.AddIgnoredActor(*It);
+		}
+	}
+	// equipment is attached to its holder where they are now, the holder is only hit through its rewound capsule
+	for (TActorIterator<AWeaponActor> It(GetWorld()); It; ++It) {
+		if (It->Holder) {
+			QueryParams.AddIgnoredActor(*It);
+		}
+	}
+	for (TActorIterator<AHealingActor> It(GetWorld()); It; ++It) {
+		if (It->Holder) {
+			QueryParams.AddIgnoredActor(*It);
+		}
+	}
+
+	TArray<FHitResult> Hits;
+	for (int Slot = 0; Slot < LiveSlots.Num(); Slot++) {
+		if (!LiveSlots[Slot]) {
+			continue;
+		}
+		const FVector Start = Locations[Slot];
+		const FVector End = Start + Velocities[Slot] * DeltaTime;
+
+		Hits.Reset();
+		// sweep with the bullet's own collision settings so pickups and triggers it ignores don't eat it
+		GetWorld()->SweepMultiByChannel(Hits, Start, End, FQuat::Identity, CollisionChannels[Slot], FCollisionShape::MakeSphere(Radii[Slot]), QueryParams, ResponseParams[Slot]);
+		Hits.Sort([](const FHitResult& A, const FHitResult& B) { return A.Time < B.Time; });
+
+		float CharacterHitTime = 1.0f;
+		AFortniteCloneCharacter* HitCharacter = RewindAndTest(Start, End, Radii[Slot], RewindTimes[Slot], Shooters[Slot].Get(), CharacterHitTime);
+
+		// resolve the world hits and the rewound character hit in the order the projectile reaches them
+		bool Stopped = false;
+		for (int i = 0; i < Hits.Num() && !Stopped; i++) {
+			if (HitCharacter && CharacterHitTime <= Hits[i].Time) {
+				Stopped = AProjectileActor::ResolveHit(HitCharacter, Damages[Slot], ProjectileTypes[Slot], Shooters[Slot].Get(), Weapons[Slot].Get());
+				HitCharacter = nullptr;
+				if (Stopped) {
+					break;
+				}
+			}
+			Stopped = AProjectileActor::ResolveHit(Hits[i].GetActor(), Damages[Slot], ProjectileTypes[Slot], Shooters[Slot].Get(), Weapons[Slot].Get(), Hits[i].bBlockingHit);
+		}
+		if (!Stopped && HitCharacter) {
+			Stopped = AProjectileActor::ResolveHit(HitCharacter, Damages[Slot], ProjectileTypes[Slot], Shooters[Slot].Get(), Weapons[Slot].Get());
+		}
+		if (Stopped) {
+			FreeSlot(Slot);
+		}
+		else {
+			Locations[Slot] = End;
+		}
+	}
+}
+
+void AProjectileManager::FireProjectile(TSubclassOf<AProjectileActor> BulletClass, const UWeaponDefinition* Definition, const FVector& Location, const FRotator& Rotation, AFortniteCloneCharacter* Shooter, AWeaponActor* Weapon) {
+	if (BulletClass == nullptr) {
+		return;
+	}
+	const AProjectileActor* BulletDefaults = BulletClass->GetDefaultObject<AProjectileActor>();
+	// the weapon definition wins wherever it sets a value
+	const float Speed = AProjectileActor::GetProjectileSpeed(BulletClass, Definition);
+
+	int Slot = AllocateSlot();
+	Locations[Slot] = Location;
+	Velocities[Slot] = Rotation.Vector() * Speed;
+	Radii[Slot] = BulletDefaults->CollisionComp ? BulletDefaults->CollisionComp->GetUnscaledSphereRadius() : 5.0f;
+	CollisionChannels[Slot] = BulletDefaults->CollisionComp ? BulletDefaults->CollisionComp->GetCollisionObjectType() : ECC_WorldDynamic;
+	ResponseParams[Slot] = BulletDefaults->CollisionComp ? FCollisionResponseParams(BulletDefaults->CollisionComp->GetCollisionResponseToChannels()) : FCollisionResponseParams::DefaultResponseParam;
+	Damages[Slot] = Definition && Definition->Damage > 0 ? Definition->Damage : BulletDefaults->Damage;
+	ProjectileTypes[Slot] = BulletDefaults->ProjectileType;
+	// rewind targets by the shooter's ping so what they saw when they fired is what gets tested
+	RewindTimes[Slot] = 0;
+	if (Shooter && Shooter->GetController() && Shooter->GetController()->PlayerState) {
+		RewindTimes[Slot] = FMath::Clamp(Shooter->GetController()->PlayerState->ExactPing * 0.001f, 0.0f, MaxRewindTime);
+	}
+	Shooters[Slot] = Shooter;
+	Weapons[Slot] = Weapon;
+
+	FProjectileExpiry Expiry;
+	Expiry.ExpireTime = GetWorld()->GetTimeSeconds() + BulletDefaults->Lifespan;
+	Expiry.Slot = Slot;
+	Expiry.Generation = Generations[Slot];
+	ExpiryQueue.HeapPush(Expiry);
+}
+
+int AProjectileManager::GetLiveProjectileCount() const {
+	return LiveProjectileCount;
+}
+
+AFortniteCloneCharacter* AProjectileManager::RewindAndTest(const FVector& Start, const FVector& End, float Radius, float RewindTime, AActor* IgnoredCharacter, float& OutHitTime) const {
+	const float TargetTime = GetWorld()->GetTimeSeconds() - RewindTime;
+	const float SegmentLength = FVector::Dist(Start, End);
+	const FVector SegmentCenter = (Start + End) * 0.5f;
+	AFortniteCloneCharacter* HitCharacter = nullptr;
+	OutHitTime = 1.0f;
+	for (int i = 0; i < Characters.Num(); i++) {
+		AFortniteCloneCharacter* FortniteCloneCharacter = Characters[i];
+		if (FortniteCloneCharacter == IgnoredCharacter || FortniteCloneCharacter->IsPendingKill()) {
+			continue;
+		}
+		const float CapsuleRadius = FortniteCloneCharacter->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		const float CapsuleHalfHeight = FortniteCloneCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		const FVector CapsuleCenter = FortniteCloneCharacter->GetRewoundLocation(TargetTime);
+		// cheap rejection before the segment test
+		const float ReachDistance = SegmentLength * 0.5f + CapsuleHalfHeight + Radius;
+		if (FVector::DistSquared(SegmentCenter, CapsuleCenter) > ReachDistance * ReachDistance) {
+			continue;
+		}
+		// the capsule is a vertical segment with a radius, the swept sphere is a segment with the projectile radius
+		const FVector CapsuleAxis(0, 0, FMath::Max(CapsuleHalfHeight - CapsuleRadius, 0.0f));
+		FVector ProjectilePoint;
+		FVector CapsulePoint;
+		FMath::SegmentDistToSegmentSafe(Start, End, CapsuleCenter - CapsuleAxis, CapsuleCenter + CapsuleAxis, ProjectilePoint, CapsulePoint);
+		if (FVector::DistSquared(ProjectilePoint, CapsulePoint) > FMath::Square(CapsuleRadius + Radius)) {
+			continue;
+		}
+		const float HitTime = SegmentLength > 0 ? FVector::Dist(Start, ProjectilePoint) / SegmentLength : 0;
+		if (HitTime < OutHitTime || HitCharacter == nullptr) {
+			OutHitTime = HitTime;
+			HitCharacter = FortniteCloneCharacter;
+		}
+	}
+	return HitCharacter;
+}
+
+int AProjectileManager::AllocateSlot() {
+	int Slot;
+	if (FreeSlots.Num() > 0) {
+		Slot = FreeSlots.Pop(false);
+	}
+	else {
+		Slot = LiveSlots.Num();
+		Locations.AddDefaulted();
+		Velocities.AddDefaulted();
+		Radii.AddDefaulted();
+		CollisionChannels.Add(ECC_WorldDynamic);
+		ResponseParams.AddDefaulted();
+		Damages.AddDefaulted();
+		ProjectileTypes.AddDefaulted();
+		RewindTimes.AddDefaulted();
+		Shooters.AddDefaulted();
+		Weapons.AddDefaulted();
+		Generations.Add(0);
+		LiveSlots.Add(false);
+	}
+	LiveSlots[Slot] = true;
+	LiveProjectileCount++;
+	return Slot;
+}
+
+void AProjectileManager::FreeSlot(int Slot) {
+	// bumping the generation invalidates the slot's entry still sitting in the expiry queue
+	LiveSlots[Slot] = false;
+	Generations[Slot]++;
+	Shooters[Slot] = nullptr;
+	Weapons[Slot] = nullptr;
+	FreeSlots.Add(Slot);
+	LiveProjectileCount--;
+}
+
+void AProjectileManager::ExpireProjectiles(float Now) {
+	while (ExpiryQueue.Num() > 0 && ExpiryQueue.HeapTop().ExpireTime <= Now) {
+		FProjectileExpiry Expiry;
+		ExpiryQueue.HeapPop(Expiry, false);
+		if (LiveSlots[Expiry.Slot] && Generations[Expiry.Slot] == Expiry.Generation) {
+			FreeSlot(Expiry.Slot);
+		}
+	}
+}
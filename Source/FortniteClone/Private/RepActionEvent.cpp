@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RepActionEvent.h"
+
+namespace
+{
+	const uint8 MontageMask = 0x0F;
+	const uint8 CounterShift = 4;
+}
+
+FRepActionEvent::FRepActionEvent()
+{
+	Packed = 0;
+	StartTime = 0;
+}
+
+void FRepActionEvent::Start(ECharacterMontage NewMontage, float Time) {
+	const uint8 Counter = ((Packed >> CounterShift) + 1) & MontageMask;
+	Packed = (uint8)(Counter << CounterShift) | ((uint8)NewMontage & MontageMask);
+	StartTime = Time;
+}
+
+ECharacterMontage FRepActionEvent::GetMontage() const {
+	return (ECharacterMontage)(Packed & MontageMask);
+}
+
+float FRepActionEvent::GetStartTime() const {
+	return StartTime;
+}
+
+bool FRepActionEvent::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) {
+	Ar << Packed;
+	Ar << StartTime;
+	bOutSuccess = true;
+	return true;
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RepAnimState.h"
+
+namespace
+{
+	const uint32 WalkingBit = 1 << 0;
+	const uint32 RunningBit = 1 << 1;
+	const uint32 HoldingWeaponBit = 1 << 2;
+	const uint32 AimedInBit = 1 << 3;
+	const uint32 WeaponTypeShift = 4;
+	const uint32 MoveXShift = 6;
+	const uint32 MoveYShift = 8;
+	const uint32 AimPitchShift = 10;
+	const uint32 AimYawShift = 20;
+	const uint32 TwoBitMask = 0x3;
+	const uint32 AngleMask = 0x3FF;
+	const int32 NumPackedBits = 30;
+
+	uint32 QuantizeAngle(float Angle) {
+		// the aim offset never goes past 90 degrees either way, so 10 bits gives roughly 0.18 degree steps
+		const float Alpha = (FMath::Clamp(Angle, -90.0f, 90.0f) + 90.0f) / 180.0f;
+		return (uint32)FMath::RoundToInt(Alpha * AngleMask);
+	}
+
+	float DequantizeAngle(uint32 Value) {
+		return ((float)Value / AngleMask) * 180.0f - 90.0f;
+	}
+
+	uint32 QuantizeMove(float Move) {
+		// blend space direction is only ever -90, 0 or 90
+		if (Move > 45.0f) {
+			return 2;
+		}
+		if (Move < -45.0f) {
+			return 0;
+		}
+		return 1;
+	}
+
+	float DequantizeMove(uint32 Value) {
+		return ((float)Value - 1.0f) * 90.0f;
+	}
+}
+
+FRepAnimState::FRepAnimState()
+{
+	Packed = 0;
+	Pack(false, false, false, false, 0, 0, 0, 0, 0);
+}
+
+bool FRepAnimState::Pack(bool IsWalking, bool IsRunning, bool HoldingWeapon, bool AimedIn, int HoldingWeaponType, float MoveX, float MoveY, float AimPitch, float AimYaw) {
+	uint32 NewPacked = 0;
+	NewPacked |= IsWalking ? WalkingBit : 0;
+	NewPacked |= IsRunning ? RunningBit : 0;
+	NewPacked |= HoldingWeapon ? HoldingWeaponBit : 0;
+	NewPacked |= AimedIn ? AimedInBit : 0;
+	NewPacked |= ((uint32)FMath::Clamp(HoldingWeaponType, 0, 2) & TwoBitMask) << WeaponTypeShift;
+	NewPacked |= QuantizeMove(MoveX) << MoveXShift;
+	NewPacked |= QuantizeMove(MoveY) << MoveYShift;
+	NewPacked |= QuantizeAngle(AimPitch) << AimPitchShift;
+	NewPacked |= QuantizeAngle(AimYaw) << AimYawShift;
+	const bool Changed = NewPacked != Packed;
+	Packed = NewPacked;
+	return Changed;
+}
+
+bool FRepAnimState::IsWalking() const {
+	return (Packed & WalkingBit) != 0;
+}
+
+bool FRepAnimState::IsRunning() const {
+	return (Packed & RunningBit) != 0;
+}
+
+bool FRepAnimState::HoldingWeapon() const {
+	return (Packed & HoldingWeaponBit) != 0;
+}
+
+bool FRepAnimState::AimedIn() const {
+	return (Packed & AimedInBit) != 0;
+}
+
+int FRepAnimState::HoldingWeaponType() const {
+	return (Packed >> WeaponTypeShift) & TwoBitMask;
+}
+
+float FRepAnimState::MoveX() const {
+	return DequantizeMove((Packed >> MoveXShift) & TwoBitMask);
+}
+
+float FRepAnimState::MoveY() const {
+	return DequantizeMove((Packed >> MoveYShift) & TwoBitMask);
+}
+
+float FRepAnimState::AimPitch() const {
+	return DequantizeAngle((Packed >> AimPitchShift) & AngleMask);
+}
+
+float FRepAnimState::AimYaw() const {
+	return DequantizeAngle((Packed >> AimYawShift) & AngleMask);
+}
+
+bool FRepAnimState::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) {
+	Ar.SerializeBits(&Packed, NumPackedBits);
+	if (Ar.IsLoading()) {
+		Packed &= (1u << NumPackedBits) - 1;
+	}
+	bOutSuccess = true;
+	return true;
+}
@@ -4,6 +4,12 @@
 #include "FortniteCloneCharacter.h"
 #include "UnrealNetwork.h"
 #include "Kismet/GameplayStatics.h"
+#include "GameFramework/GameStateBase.h"
+#include "FortniteClone.h"
+#include "MatchProfiler.h"
+#include "MatchEventLog.h"
+
+DECLARE_CYCLE_STAT(TEXT("Storm Tick"), STAT_StormTick, STATGROUP_FortniteClone);
 
 // Sets default values
 AStormActor::AStormActor()
@@ -12,30 +18,40 @@ AStormActor::AStormActor()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 	Damage = 1;
-	IsShrinking = false;
-	SizeScale = GetActorScale3D();
-	Stage = 0; //Stages 0, 1, 2, 3, the circle is not shrinking, stage 4 the circle is shrinking and sets back to 1 afterwards
+	// the circle holds for 2 minutes and then shrinks for the last 30 seconds of every 2 and a half minute interval
+	WaitDuration = 120.0f;
+	ShrinkDuration = 30.0f;
+	// the old per tick scale of 0.99925 over 30 seconds of 60 Hz ticks left about 0.26 of the radius
+	ShrinkRatio = 0.26f;
+	InitialRadius = 0;
+	InitialScale = FVector(1);
 }
 
 // Called when the game starts or when spawned
 void AStormActor::BeginPlay()
 {
 	Super::BeginPlay();
+	InitialScale = GetActorScale3D();
+	InitialRadius = GetComponentsBoundingBox().GetExtent().X;
+	// the game mode tests characters against the radius directly, the mesh is only visual and has no need for overlaps
+	SetActorEnableCollision(false);
+	if (GetNetMode() == NM_DedicatedServer) {
+		// the server only evaluates the radius when it needs it, the mesh is never rescaled there
+		SetActorTickEnabled(false);
+	}
 	if (HasAuthority()) {
 		//move the storm to a random location on the map
 		int32 X = FMath::RandRange(-7000 + 10000, 60000 - 10000);
 		int32 Y = FMath::RandRange(-60000 + 10000, 17000 - 10000);
 		SetActorLocation(FVector(X, Y, GetActorLocation().Z));
-		FString LogMsg = FString("storm actor constructor ") + FString::FromInt(X) + FString(" ") + FString::FromInt(Y);
-		UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
+		Phase.Center = GetActorLocation();
+		Phase.StartRadius = InitialRadius;
+		Phase.EndRadius = InitialRadius;
+		FMatchEventLog::Get().Record(EMatchEvent::StormPhase, 0, 0, -1, -1, Phase.EndRadius, Phase.Center);
 		//after 30 seconds, start shrinking the circle at the last 30 seconds of every 2 and a half minute interval
 		//FTimerHandle StormSetupTimerHandle;
 		//GetWorldTimerManager().SetTimer(StormSetupTimerHandle, this, &AStormActor::ServerStartStorm, 30.0f, false);
-		LogMsg = FString("begin play circle ") + FString::FromInt(GetNetMode());
-		UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
 	}
-	FString LogMsg = FString("begin play circle ") + FString::FromInt(GetNetMode());
-	UE_LOG(LogMyGame, Warning, TEXT("%s"), *LogMsg);
 	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString("Storm Begin Play ") + FString::FromInt(GetNetMode()));
 }
 
@@ -43,38 +59,66 @@ void AStormActor::BeginPlay()
 void AStormActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-	if (HasAuthority()) {
-		if (IsShrinking) {
-			FVector NewScale = FVector(SizeScale.X * 0.99925, SizeScale.Y * 0.99925, SizeScale.Z);
-			SizeScale = NewScale;
-			SetActorScale3D(SizeScale);
-		}
-	}
+	SCOPE_CYCLE_COUNTER(STAT_StormTick);
+	FMatchProfiler::FScope ProfileScope(EProfiledScope::StormTick);
+	UpdateStormScale();
 }
 
 void AStormActor::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME(AStormActor, Damage);
-	DOREPLIFETIME(AStormActor, IsShrinking);
-	DOREPLIFETIME(AStormActor, SizeScale);
+	DOREPLIFETIME(AStormActor, Phase);
 }
 
-void AStormActor::ServerSetIsShrinking_Implementation() {
-	if (Stage == 4) {
-		Stage = 0;
-		IsShrinking = !IsShrinking;
+float AStormActor::GetServerTime() const {
+	AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+float AStormActor::GetCurrentRadius() const {
+	if (Phase.StartRadius <= 0) {
+		return InitialRadius; // phase has not replicated yet
 	}
-	else {
-		Stage = Stage + 1;
-		if (Stage == 4) {
-			IsShrinking = !IsShrinking;
-		}
+	const float Duration = Phase.EndTime - Phase.StartTime;
+	if (Duration <= 0) {
+		return Phase.EndRadius;
 	}
+	const float Alpha = FMath::Clamp((GetServerTime() - Phase.StartTime) / Duration, 0.0f, 1.0f);
+	return FMath::Lerp(Phase.StartRadius, Phase.EndRadius, Alpha);
 }
 
-bool AStormActor::ServerSetIsShrinking_Validate() {
-	return true;
+bool AStormActor::IsInSafeZone(const FVector& Location) const {
+	const float Radius = GetCurrentRadius();
+	return FVector::DistSquared2D(Location, Phase.Center) <= Radius * Radius;
+}
+
+void AStormActor::OnRep_Phase() {
+	UpdateStormScale();
+}
+
+void AStormActor::UpdateStormScale() {
+	if (InitialRadius <= 0) {
+		return;
+	}
+	const float Ratio = GetCurrentRadius() / InitialRadius;
+	const FVector NewScale = FVector(InitialScale.X * Ratio, InitialScale.Y * Ratio, InitialScale.Z);
+	if (!NewScale.Equals(GetActorScale3D())) {
+		SetActorScale3D(NewScale);
+	}
+}
+
+void AStormActor::ServerStartNextPhase() {
+	// the next shrink starts from wherever the last one ended
+	const float Now = GetServerTime();
+	FStormPhase NextPhase;
+	NextPhase.Center = GetActorLocation();
+	NextPhase.StartRadius = GetCurrentRadius();
+	NextPhase.EndRadius = NextPhase.StartRadius * ShrinkRatio;
+	NextPhase.StartTime = Now + WaitDuration;
+	NextPhase.EndTime = NextPhase.StartTime + ShrinkDuration;
+	Phase = NextPhase;
+	FMatchEventLog::Get().Record(EMatchEvent::StormPhase, 0, 0, -1, -1, Phase.EndRadius, Phase.Center);
 }
 
 void AStormActor::ServerSetNewDamage_Implementation() {
@@ -86,8 +130,9 @@ bool AStormActor::ServerSetNewDamage_Validate() {
 }
 
 void AStormActor::ServerStartStorm_Implementation() {
-	FTimerHandle StormDamageTimerHandle;
-	GetWorldTimerManager().SetTimer(StormDamageTimerHandle, this, &AStormActor::ServerSetIsShrinking, 30.0f, true);
+	ServerStartNextPhase();
+	FTimerHandle StormPhaseTimerHandle;
+	GetWorldTimerManager().SetTimer(StormPhaseTimerHandle, this, &AStormActor::ServerStartNextPhase, WaitDuration + ShrinkDuration, true);
 	FTimerHandle StormStateTimerHandle;
 	GetWorldTimerManager().SetTimer(StormStateTimerHandle, this, &AStormActor::ServerSetNewDamage, 180.0f, true);
 }
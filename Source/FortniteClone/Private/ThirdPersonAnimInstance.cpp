@@ -24,27 +24,9 @@ UThirdPersonAnimInstance::UThirdPersonAnimInstance()
 	RunningY = 0;
 };
 
-void UThirdPersonAnimInstance::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	DOREPLIFETIME(UThirdPersonAnimInstance, IsRunning);
-	DOREPLIFETIME(UThirdPersonAnimInstance, IsWalking);
-	DOREPLIFETIME(UThirdPersonAnimInstance, HoldingWeapon);
-	DOREPLIFETIME(UThirdPersonAnimInstance, AimedIn);
-	DOREPLIFETIME(UThirdPersonAnimInstance, HoldingWeaponType);
-	DOREPLIFETIME(UThirdPersonAnimInstance, Speed);
-	DOREPLIFETIME(UThirdPersonAnimInstance, AimPitch);
-	DOREPLIFETIME(UThirdPersonAnimInstance, AimYaw);
-	DOREPLIFETIME(UThirdPersonAnimInstance, InterpSpeed);
-	DOREPLIFETIME(UThirdPersonAnimInstance, WalkingX);
-	DOREPLIFETIME(UThirdPersonAnimInstance, WalkingY);
-	DOREPLIFETIME(UThirdPersonAnimInstance, RunningX);
-	DOREPLIFETIME(UThirdPersonAnimInstance, RunningY);
-}
-
 void UThirdPersonAnimInstance::NativeUpdateAnimation(float DeltaSeconds) {
 	Super::NativeUpdateAnimation(DeltaSeconds);
+	// the character fields are written by the server directly and by OnRep_AnimState on clients
 	AFortniteCloneCharacter* FortniteCloneCharacter = Cast<AFortniteCloneCharacter>(TryGetPawnOwner());
 	if (FortniteCloneCharacter) {
 		IsWalking = FortniteCloneCharacter->IsWalking;
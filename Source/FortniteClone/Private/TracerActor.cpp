@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TracerActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "ProjectileActor.h"
+
+// Sets default values
+ATracerActor::ATracerActor()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bReplicates = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
+
+	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
+	MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeshComponent->SetGenerateOverlapEvents(false);
+	MeshComponent->SetCastShadow(false);
+	MeshComponent->SetupAttachment(RootComponent);
+
+	Velocity = FVector::ZeroVector;
+}
+
+// Called every frame
+void ATracerActor::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SetActorLocation(GetActorLocation() + Velocity * DeltaTime);
+}
+
+void ATracerActor::Initialize(TSubclassOf<AProjectileActor> BulletClass, const UWeaponDefinition* Definition) {
+	if (BulletClass == nullptr) {
+		return;
+	}
+	const AProjectileActor* BulletDefaults = BulletClass->GetDefaultObject<AProjectileActor>();
+	Velocity = GetActorForwardVector() * AProjectileActor::GetProjectileSpeed(BulletClass, Definition);
+	SetLifeSpan(BulletDefaults->Lifespan);
+	// the bullet blueprints add their mesh in the construction script, borrow it instead of spawning the bullet
+	UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(*BulletClass);
+	if (BlueprintClass && BlueprintClass->SimpleConstructionScript) {
+		for (USCS_Node* Node : BlueprintClass->SimpleConstructionScript->GetAllNodes()) {
+			UStaticMeshComponent* Template = Node ? Cast<UStaticMeshComponent>(Node->ComponentTemplate) : nullptr;
+			if (Template && Template->GetStaticMesh()) {
+				MeshComponent->SetStaticMesh(Template->GetStaticMesh());
+				MeshComponent->SetRelativeTransform(Template->GetRelativeTransform());
+				for (int i = 0; i < Template->GetNumMaterials(); i++) {
+					MeshComponent->SetMaterial(i, Template->GetMaterial(i));
+				}
+				break;
+			}
+		}
+	}
+}
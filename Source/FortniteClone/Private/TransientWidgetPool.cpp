@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TransientWidgetPool.h"
+#include "Blueprint/UserWidget.h"
+#include "Animation/WidgetAnimation.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+UTransientWidgetPool::UTransientWidgetPool()
+{
+	DefaultLifetime = 0.5f;
+	OwningPlayer = nullptr;
+	MaxCount = 0;
+}
+
+void UTransientWidgetPool::Init(APlayerController* InOwningPlayer, TSubclassOf<UUserWidget> InWidgetClass, int PreallocateCount, int InMaxCount) {
+	OwningPlayer = InOwningPlayer;
+	WidgetClass = InWidgetClass;
+	MaxCount = FMath::Max(InMaxCount, 1);
+	Widgets.Reserve(MaxCount);
+	Animations.Reserve(MaxCount);
+	ReleaseTimes.Reserve(MaxCount);
+	for (int i = 0; i < FMath::Min(PreallocateCount, MaxCount); i++) {
+		CreatePooledWidget();
+	}
+}
+
+UUserWidget* UTransientWidgetPool::Show() {
+	if (OwningPlayer == nullptr || WidgetClass == nullptr) {
+		return nullptr;
+	}
+	int Index = INDEX_NONE;
+	for (int i = 0; i < Widgets.Num(); i++) {
+		if (ReleaseTimes[i] == 0) {
+			Index = i;
+			break;
+		}
+	}
+	if (Index == INDEX_NONE && Widgets.Num() < MaxCount) {
+		Index = CreatePooledWidget();
+	}
+	if (Index == INDEX_NONE && Widgets.Num() > 0) {
+		// pool is full, take over the widget that has been up the longest
+		Index = 0;
+		for (int i = 1; i < Widgets.Num(); i++) {
+			if (ReleaseTimes[i] < ReleaseTimes[Index]) {
+				Index = i;
+			}
+		}
+	}
+	if (Index == INDEX_NONE) {
+		return nullptr;
+	}
+	UUserWidget* Widget = Widgets[Index];
+	UWidgetAnimation* Animation = Animations[Index];
+	float Lifetime = DefaultLifetime;
+	Widget->SetVisibility(ESlateVisibility::HitTestInvisible);
+	if (Animation) {
+		Widget->PlayAnimation(Animation, 0.0f, 1);
+		Lifetime = Animation->GetEndTime();
+	}
+	ReleaseTimes[Index] = OwningPlayer->GetWorld()->GetTimeSeconds() + Lifetime;
+	return Widget;
+}
+
+void UTransientWidgetPool::Update(float Now) {
+	for (int i = 0; i < Widgets.Num(); i++) {
+		if (ReleaseTimes[i] != 0 && Now >= ReleaseTimes[i]) {
+			Release(i);
+		}
+	}
+}
+
+int UTransientWidgetPool::CreatePooledWidget() {
+	UUserWidget* Widget = CreateWidget<UUserWidget>(OwningPlayer, WidgetClass);
+	if (Widget == nullptr) {
+		return INDEX_NONE;
+	}
+	// added once and kept in the viewport, showing and hiding only changes visibility
+	Widget->AddToViewport();
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	// the animation is a blueprint variable on the widget class, take the first one
+	UWidgetAnimation* Animation = nullptr;
+	for (TFieldIterator<UObjectProperty> It(Widget->GetClass()); It; ++It) {
+		if (It->PropertyClass == UWidgetAnimation::StaticClass()) {
+			Animation = Cast<UWidgetAnimation>(It->GetObjectPropertyValue_InContainer(Widget));
+			break;
+		}
+	}
+	Widgets.Add(Widget);
+	Animations.Add(Animation);
+	return ReleaseTimes.Add(0);
+}
+
+void UTransientWidgetPool::Release(int Index) {
+	if (Animations[Index]) {
+		Widgets[Index]->StopAnimation(Animations[Index]);
+	}
+	Widgets[Index]->SetVisibility(ESlateVisibility::Collapsed);
+	ReleaseTimes[Index] = 0;
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WeaponDefinition.h"
+#include "WeaponActor.h"
+
+const FPrimaryAssetType UWeaponDefinition::PrimaryAssetType = TEXT("WeaponDefinition");
+
+UWeaponDefinition::UWeaponDefinition()
+{
+	WeaponId = 0;
+	UsesAmmunition = true;
+	Damage = 0;
+	FireInterval = 0.233f;
+	Spread = 0;
+	PelletCount = 1;
+	ProjectileSpeed = 0;
+	MagazineSize = 0;
+	ReloadTime = 2.167f;
+	FireAction = EPlayerAction::ShootRifle;
+	ReloadAction = EPlayerAction::ReloadRifle;
+	FireMontage = ECharacterMontage::ShootRifle;
+	AimedFireMontage = ECharacterMontage::ShootRifleIronsights;
+	ReloadMontage = ECharacterMontage::ReloadRifle;
+	AimedReloadMontage = ECharacterMontage::ReloadRifleIronsights;
+}
+
+FPrimaryAssetId UWeaponDefinition::GetPrimaryAssetId() const {
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+int UWeaponDefinition::GetMagazineSize(const AWeaponActor* Weapon) const {
+	return MagazineSize > 0 || Weapon == nullptr ? MagazineSize : Weapon->MagazineSize;
+}
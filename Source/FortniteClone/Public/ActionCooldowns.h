@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionCooldowns.generated.h"
+
+/* Actions that lock the player out of other actions while they play */
+UENUM()
+enum class EPlayerAction : uint8
+{
+	ShootRifle,
+	ShootShotgun,
+	SwingPickaxe,
+	UseBandage,
+	ReloadRifle,
+	ReloadShotgun,
+	Count UMETA(Hidden)
+};
+
+/**
+ * Time until which each action is still playing, measured on the server's world clock
+ * Starting an action only stores a timestamp, nothing is scheduled, and an action is over once the clock passes it
+ */
+USTRUCT()
+struct FORTNITECLONE_API FActionCooldowns
+{
+	GENERATED_BODY()
+
+	static const int ActionCount = (int)EPlayerAction::Count;
+
+	FActionCooldowns();
+
+	/* True while the action started less than its duration ago */
+	bool IsActive(EPlayerAction Action, float Now) const;
+
+	/* True while any action is playing */
+	bool IsAnyActive(float Now) const;
+
+	void Start(EPlayerAction Action, float Now, float Duration);
+
+	/* Ends the action immediately */
+	void Cancel(EPlayerAction Action);
+
+	void CancelAll();
+
+	UPROPERTY()
+	float NextAllowedTime[ActionCount];
+};
@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/CoreNet.h"
+
+class AActor;
+class UFunction;
+class UNetConnection;
+class UProperty;
+
+/* What a row of the bandwidth report is about */
+enum class EBandwidthCategory : uint8
+{
+	Connection, // everything sent to one client
+	RPC, // one remote function, summed over the connections it went to
+	Property, // one replicated property, summed over the connections it went to
+	Count
+};
+
+/**
+ * Server side record of the bytes sent to clients, broken down by connection, by RPC and by replicated property
+ * Connection and RPC bytes are measured from the connection's send buffer, property bytes are estimated from the size of the values that changed,
+ * since the engine doesn't expose what each property costs outside of the network profiler
+ * Totals roll over every minute into a CSV in the profiling directory, recording is off unless the server runs with -netaccounting or fc.NetAccounting on
+ */
+class FORTNITECLONE_API FBandwidthAccounting
+{
+public:
+	static FBandwidthAccounting& Get();
+
+	bool IsEnabled() const;
+
+	/* Turning recording off writes out the minute in progress */
+	void SetEnabled(bool Enabled);
+
+	void AddConnectionBits(UNetConnection* Connection, int64 Bits);
+
+	void AddRPCBits(UFunction* Function, UNetConnection* Connection, int64 Bits);
+
+	/* Compares the replicated properties of the actor and its replicated components against the values seen last frame,
+	   and charges the changed ones to the open channels their replication condition sends them to */
+	void SampleProperties(AActor* Actor, int OpenChannels);
+
+	/* Writes the minute in progress to the CSV once it is over */
+	void Tick(double Now);
+
+	/* Logs the largest rows of the minute in progress and of the whole recording */
+	void Dump(int MaxRows) const;
+
+	/* Appends the minute in progress to the CSV and starts a new one */
+	void Flush();
+
+private:
+	struct FBandwidthTotal
+	{
+		FBandwidthTotal() : Bits(0), Count(0) {}
+
+		int64 Bits;
+		int32 Count;
+	};
+
+	/* Copy of a property's value from the last sample */
+	struct FPropertySnapshot
+	{
+		UProperty* Property;
+		uint8* Value;
+		ELifetimeCondition Condition;
+	};
+
+	static const int CategoryCount = (int)EBandwidthCategory::Count;
+
+	void Add(EBandwidthCategory Category, const FString& Name, int64 Bits);
+
+	/* Samples one actor or replicated component */
+	void SampleObject(UObject* Object, int OpenChannels);
+
+	/* Number of the open channels a property with this condition is sent to after the initial bunch */
+	static int GetReceivingChannels(ELifetimeCondition Condition, int OpenChannels);
+
+	static FString GetConnectionName(UNetConnection* Connection);
+
+	/* Frees the snapshots of actors and components that have been destroyed */
+	void PurgeSnapshots();
+
+	void ClearSnapshots();
+
+	bool Enabled;
+
+	/* Totals for the minute in progress */
+	TMap<FString, FBandwidthTotal> MinuteTotals[CategoryCount];
+
+	/* Totals since recording started */
+	TMap<FString, FBandwidthTotal> RecordingTotals[CategoryCount];
+
+	TMap<TWeakObjectPtr<UObject>, TArray<FPropertySnapshot>> Snapshots;
+
+	FString CsvPath;
+
+	int Minute;
+
+	double MinuteStartTime;
+
+	FBandwidthAccounting();
+};
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Slot a building piece occupies inside a grid cell */
+enum class EBuildSlot : uint8
+{
+	Floor,
+	Ramp,
+	WallX, // wall on the cell face perpendicular to the X axis
+	WallY  // wall on the cell face perpendicular to the Y axis
+};
+
+/**
+ * World build grid with a fixed cell size, every cell has one floor, one ramp and two wall slots
+ * Occupied slots are kept in a hash set keyed by the packed cell coordinates and slot, so placement is checked before anything is spawned
+ */
+struct FORTNITECLONE_API FBuildGrid
+{
+	/* Width, depth and height of a cell in world units */
+	static const float CellSize;
+
+	/* Thickness used for the bounds of walls and floors */
+	static const float PieceThickness;
+
+	/* Snaps a piece (0 wall, 1 ramp, 2 floor) placed at DesiredLocation by someone facing Facing to a slot, returns the slot key */
+	static uint64 SnapToSlot(int PieceIndex, const FVector& DesiredLocation, const FRotator& Facing, FTransform& OutTransform);
+
+	/* World space bounds of whatever occupies the slot, for a ramp this is the whole cell it climbs through */
+	static FBox GetSlotBounds(uint64 SlotKey);
+
+	/* True if an upright capsule touches the piece snapped to the slot, ramps are tested against the inclined slab rather than the cell */
+	static bool CapsuleIntersectsPiece(uint64 SlotKey, const FTransform& PieceTransform, const FVector& CapsuleCenter, float Radius, float HalfHeight);
+
+	/* True if an upright capsule touches the box */
+	static bool CapsuleIntersectsBox(const FVector& CapsuleCenter, float Radius, float HalfHeight, const FBox& Box);
+
+	bool IsOccupied(uint64 SlotKey) const;
+
+	void Occupy(uint64 SlotKey);
+
+	void Release(uint64 SlotKey);
+
+	void Reset();
+
+private:
+	static uint64 MakeSlotKey(int32 X, int32 Y, int32 Z, EBuildSlot Slot);
+
+	static void BreakSlotKey(uint64 SlotKey, int32& OutX, int32& OutY, int32& OutZ, EBuildSlot& OutSlot);
+
+	TSet<uint64> OccupiedSlots;
+};
@@ -21,10 +21,18 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Preview")
 	bool IsPreview;
 
+	/* Build grid slot this piece occupies on the server, only valid if InBuildGrid is set */
+	uint64 BuildGridSlot;
+
+	bool InBuildGrid;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Frees the build grid slot when the piece is destroyed
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
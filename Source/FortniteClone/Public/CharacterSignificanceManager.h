@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "CharacterSignificanceManager.generated.h"
+
+class AFortniteCloneCharacter;
+class UFortniteCloneReplicationGraph;
+
+/* How much a character matters to whoever is looking at it, each bucket has its own update rates */
+UENUM()
+enum class ESignificanceBucket : uint8
+{
+	High, // close by or fighting
+	Medium, // in view at mid range
+	Low, // far away or out of view
+	Count UMETA(Hidden)
+};
+
+/**
+ * Ranks every character by distance, visibility and combat activity a few times a second and slows down the ones that matter least
+ * On the server the rank is against the nearest player and only changes how often the replication graph sends the character, lag compensation needs every server frame
+ * On clients the rank is against the local view and changes the actor tick interval and the mesh tick interval that drives animation
+ */
+UCLASS(Config = Game)
+class FORTNITECLONE_API UCharacterSignificanceManager : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UCharacterSignificanceManager();
+
+	/* Re-ranks every character in the world */
+	void Update();
+
+	/* Characters closer than this are always high significance */
+	UPROPERTY(Config)
+	float HighDistance;
+
+	/* Characters in view and closer than this are medium significance */
+	UPROPERTY(Config)
+	float MediumDistance;
+
+	/* Seconds after a montage starts that a character still counts as fighting */
+	UPROPERTY(Config)
+	float CombatGraceTime;
+
+	/* Net update frequency for each bucket, high first */
+	UPROPERTY(Config)
+	float NetUpdateFrequencies[(int)ESignificanceBucket::Count];
+
+	/* Actor tick interval for each bucket on clients, 0 ticks every frame */
+	UPROPERTY(Config)
+	float TickIntervals[(int)ESignificanceBucket::Count];
+
+	/* Mesh tick interval for each bucket on clients, sets how often the animation is evaluated */
+	UPROPERTY(Config)
+	float AnimationIntervals[(int)ESignificanceBucket::Count];
+
+private:
+	ESignificanceBucket GetBucket(AFortniteCloneCharacter* Character, float DistanceSquared, bool Visible, float Now) const;
+
+	void ApplyBucket(AFortniteCloneCharacter* Character, ESignificanceBucket Bucket, bool IsServer, UFortniteCloneReplicationGraph* ReplicationGraph);
+
+	/* Where the ranking is measured from, every player controlled character on the server or the camera on a client */
+	TArray<FVector> ViewerLocations;
+
+	/* Character at each viewer location, null for a client camera */
+	TArray<AFortniteCloneCharacter*> ViewerCharacters;
+};
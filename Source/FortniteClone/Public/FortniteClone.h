@@ -3,3 +3,5 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+DECLARE_STATS_GROUP(TEXT("FortniteClone"), STATGROUP_FortniteClone, STATCAT_Advanced);
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetManager.h"
+#include "FortniteCloneAssetManager.generated.h"
+
+class UWeaponDefinition;
+
+/**
+ * Asset manager that loads every weapon definition at startup into one table indexed by weapon id
+ * Firing and reloading look their weapon up with an array index instead of branching on the weapon type
+ */
+UCLASS()
+class FORTNITECLONE_API UFortniteCloneAssetManager : public UAssetManager
+{
+	GENERATED_BODY()
+
+public:
+	virtual void StartInitialLoading() override;
+
+	static UFortniteCloneAssetManager& Get();
+
+	/* Definition for a weapon type, null if no weapon uses that id */
+	static const UWeaponDefinition* GetWeaponDefinition(int WeaponId);
+
+	/* One past the highest weapon id */
+	int GetWeaponCount() const;
+
+private:
+	/* Fills the ids of the original weapons that don't have an asset yet with their old hard coded values */
+	void AddBuiltInWeaponDefinitions();
+
+	/* Indexed by weapon id, ids nothing uses are null */
+	UPROPERTY()
+	TArray<UWeaponDefinition*> WeaponTable;
+};
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "FortniteCloneBotController.generated.h"
+
+class AFortniteCloneCharacter;
+
+/* Scripted behavior a bot follows for the whole match */
+UENUM()
+enum class EBotProfile : uint8
+{
+	BuildFight, // close in on the nearest player, shoot and throw up walls
+	StormRush, // sprint for the middle of the safe circle, shooting anyone on the way
+	Wander // walk around and pick up loot
+};
+
+/**
+ * Server side stand in for a player used to load test the dedicated server
+ * It drives the character through the same input handlers and server functions a real player's input reaches,
+ * so movement, firing, building, weapon switching and pickups cost the same as they do for a person
+ */
+UCLASS()
+class FORTNITECLONE_API AFortniteCloneBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AFortniteCloneBotController();
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual void Possess(APawn* InPawn) override;
+
+	/* Parses a profile name from the console or command line, unknown names give Wander */
+	static EBotProfile ParseProfile(const FString& Name);
+
+	EBotProfile Profile;
+
+	/* Seconds between decisions, input is still applied every frame */
+	float ThinkInterval;
+
+	/* Players closer than this are shot at */
+	float EngageDistance;
+
+private:
+	/* Picks a destination and fires, builds or switches weapons for the next ThinkInterval */
+	UFUNCTION()
+	void Think();
+
+	void ThinkBuildFight(AFortniteCloneCharacter* Character);
+
+	void ThinkStormRush(AFortniteCloneCharacter* Character);
+
+	void ThinkWander(AFortniteCloneCharacter* Character);
+
+	/* Shoots at the target with the best weapon owned, reloading is handled by the fire function */
+	void Engage(AFortniteCloneCharacter* Character, AFortniteCloneCharacter* Target);
+
+	AFortniteCloneCharacter* FindNearestEnemy(AFortniteCloneCharacter* Character) const;
+
+	/* Nearest weapon lying on the ground, null if there is none within range */
+	AActor* FindNearestLoot(AFortniteCloneCharacter* Character, float Range) const;
+
+	FVector Destination;
+
+	bool HasDestination;
+
+	/* -1, 0 or 1, applied to the strafe input every frame */
+	float StrafeInput;
+
+	bool Sprinting;
+
+	FTimerHandle ThinkTimerHandle;
+};
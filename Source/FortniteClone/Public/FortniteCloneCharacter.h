@@ -4,16 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "RepAnimState.h"
+#include "RepActionEvent.h"
 #include "FortniteCloneCharacter.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogMyGame, Log, All);
 
 class ABuildingActor;
 class AWeaponActor;
+class AProjectileActor;
 class AHealingActor;
 class AFortniteClonePlayerState;
 class UThirdPersonAnimInstance;
 class AStormActor;
+class UFortniteCloneCharacterMovement;
+
+/* Capsule location of a character at a server time, used for lag compensation */
+struct FHitboxSample
+{
+	float Time;
+	FVector Location;
+};
 
 UCLASS(config=Game)
 class AFortniteCloneCharacter : public ACharacter
@@ -32,7 +43,7 @@ class AFortniteCloneCharacter : public ACharacter
 	class UCapsuleComponent* TriggerCapsule;
 
 public:
-	AFortniteCloneCharacter();
+	AFortniteCloneCharacter(const FObjectInitializer& ObjectInitializer);
 
 	/** Base turn rate, in deg/sec. Other scaling may affect final turn rate. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Camera)
@@ -66,6 +77,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Floor")
 	TArray<TSubclassOf<ABuildingActor>> FloorClasses;
 
+	/* Materials swapped onto an existing preview when the building material changes, indexed by building material */
+	UPROPERTY(EditDefaultsOnly, Category = "Preview")
+	TArray<UMaterialInterface*> PreviewMaterials;
+
 	/* Array of weapon classes */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
 	TArray<TSubclassOf<AWeaponActor>> WeaponClasses;
@@ -110,12 +125,20 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Reload")
 	UAnimMontage* ShotgunIronsightsReloadAnimation;
 
-	UPROPERTY(EditDefaultsOnly, Replicated, Category = "Health")
+	UPROPERTY(EditDefaultsOnly, ReplicatedUsing = OnRep_Health, Category = "Health")
 	float Health;
 
+	/* Pushes the new health to the HUD, the server calls it itself after changing health */
+	UFUNCTION()
+	void OnRep_Health();
+
 	UFUNCTION(BlueprintPure, Category = "Health")
 	float GetHealth();
 
+	/* False as soon as health reaches 0, before the game mode gets to the death, movement, input and server actions stop from then on */
+	UFUNCTION(BlueprintPure, Category = "Health")
+	bool IsAlive() const;
+
 	UFUNCTION(BlueprintPure, Category = "Material")
 	int GetWoodMaterialCount();
 
@@ -143,55 +166,146 @@ public:
 	UPROPERTY(Replicated)
 	AHealingActor* CurrentHealingItem;
 
+	/* One instance of every weapon owned, indexed by weapon type and sized from the weapon table, the ones not being held stay attached but hidden */
+	UPROPERTY(ReplicatedUsing = OnRep_ActiveEquipmentSlot)
+	TArray<AWeaponActor*> WeaponPool;
+
+	/* Bandage instance, spawned the first time bandages are equipped */
+	UPROPERTY(ReplicatedUsing = OnRep_ActiveEquipmentSlot)
+	AHealingActor* HealingItemPool;
+
+	/* Weapon type of the pooled item being held, -1 for the bandage and -2 while in build mode */
+	UPROPERTY(ReplicatedUsing = OnRep_ActiveEquipmentSlot)
+	int ActiveEquipmentSlot;
+
+	UFUNCTION()
+	void OnRep_ActiveEquipmentSlot();
+
+	/* Shows the pooled item in the active slot and hides the rest */
+	void UpdateEquipmentVisibility();
+
+	/* Holds the pooled item for a weapon type (-1 for the bandage), the item is only spawned if it has never been held before */
+	void EquipFromPool(int WeaponType, AFortniteClonePlayerState* State);
+
+	/* Hides the item being held, it stays in the pool for the next equip */
+	void StowEquipment(AFortniteClonePlayerState* State);
+
+	/* Enters build mode, switches to another build mode or leaves build mode if already building the same piece */
+	void ToggleBuildMode(const FString& Mode);
+
+	/* True while the reload action of any weapon in the weapon table is running */
+	bool IsReloading(const AFortniteClonePlayerState* State) const;
+
+	/* True while a weapon other than WeaponId is between shots, the pickaxe swing counts as a shot, -1 checks every weapon */
+	bool IsFiringOtherWeapon(const AFortniteClonePlayerState* State, int WeaponId) const;
+
 	/* Pointer to storm instance to get current damage */
 	UPROPERTY(Replicated)
 	AStormActor* CurrentStorm;
 
-	/* Current preview of wall to be built in build mode */
-	UPROPERTY(Replicated)
-	ABuildingActor* BuildingPreview;
+	/* Local build previews for the controlling client, one per piece type (0 wall, 1 ramp, 2 floor), never replicated */
+	UPROPERTY(Transient)
+	TArray<ABuildingActor*> BuildingPreviews;
 
-	/* Anim instance properties */
-	UPROPERTY(Replicated)
+	/* Building material each preview is currently showing, -1 if it has not been spawned */
+	TArray<int> BuildingPreviewMaterials;
+
+	/* Anim instance properties, set on the server and unpacked from AnimState on clients */
 	bool IsRunning;
 
-	UPROPERTY(Replicated)
 	bool IsWalking;
 
-	UPROPERTY(Replicated)
 	float WalkingX;
 
-	UPROPERTY(Replicated)
 	float WalkingY;
 
-	UPROPERTY(Replicated)
 	float RunningX;
 
-	UPROPERTY(Replicated)
 	float RunningY;
 
-	UPROPERTY(Replicated)
 	bool HoldingWeapon;
 
-	UPROPERTY(Replicated)
 	bool AimedIn;
 
-	UPROPERTY(Replicated)
 	int HoldingWeaponType;
 
-	UPROPERTY(Replicated)
 	float AimPitch;
 
-	UPROPERTY(Replicated)
 	float AimYaw;
 
-	UPROPERTY(Replicated)
+	/* How fast the aim offset follows the view, also used by clients to smooth toward the replicated aim */
 	float InterpSpeed;
 
+	/* Packed copy of the anim instance properties, the only one of them that is replicated */
+	UPROPERTY(ReplicatedUsing = OnRep_AnimState)
+	FRepAnimState AnimState;
+
+	/* Aim offset last received from the server, clients interpolate AimPitch and AimYaw toward it */
+	float ReplicatedAimPitch;
+
+	float ReplicatedAimYaw;
+
+	UFUNCTION()
+	void OnRep_AnimState();
+
+	/* Last montage started by the server, replaces a multicast per montage so it follows relevancy and update rate */
+	UPROPERTY(ReplicatedUsing = OnRep_ActionEvent)
+	FRepActionEvent ActionEvent;
+
+	UFUNCTION()
+	void OnRep_ActionEvent();
+
+	/* Only called on the server, plays the montage locally and replicates it to everyone */
+	void PlayActionMontage(ECharacterMontage Montage);
+
+	UAnimMontage* GetActionMontage(ECharacterMontage Montage) const;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category="Storm")
 	bool InStorm;
 
+	/* Number of server frames of capsule history kept for lag compensation */
+	static const int HitboxHistorySize = 64;
+
+	/* Ring buffer of capsule locations recorded every server frame, HitboxHistoryHead is the next slot to write */
+	FHitboxSample HitboxHistory[HitboxHistorySize];
+
+	int HitboxHistoryHead;
+
+	int HitboxHistoryNum;
+
+	/* Records the current capsule location at the given server time */
+	void RecordHitboxSample(float Time);
+
+	/* Set on the server when a bandage is used, the heal is applied once the bandage cooldown has run out */
+	bool BandageHealPending;
+
+	/* Applies the pending bandage heal once the player is done bandaging */
+	void ApplyPendingBandageHeal();
+
+	/* Capsule location at a past server time, interpolated between recorded samples */
+	FVector GetRewoundLocation(float Time) const;
+
+	/* Returns 0 for wall, 1 for ramp, 2 for floor and -1 for anything else */
+	int GetBuildPieceIndex(const FString& Mode) const;
+
+	/* Snaps where a piece would be placed right now to the build grid, shared by the local preview and the server build */
+	uint64 GetBuildSlot(int PieceIndex, FTransform& OutTransform) const;
+
+	/* Moves the preview for the current build mode and hides the others, only runs on the controlling client */
+	void UpdateBuildingPreviews();
+
+	/* Returns the preview for a piece type in the given material, swapping its material or respawning it only when needed */
+	ABuildingActor* GetBuildingPreview(int PieceIndex, int Material);
+
+	/* Returns the movement component carrying the walk/run flags */
+	UFortniteCloneCharacterMovement* GetFortniteCloneMovement() const;
+
+	/* Applies the locomotion state decoded from the latest move, X and Y are the -90/0/90 blend space values */
+	void SetLocomotionState(bool bWalking, bool bRunning, int8 MoveX, int8 MoveY);
+
 protected:
+	// bots drive the same input handlers as a player's key bindings
+	friend class AFortniteCloneBotController;
 
 	/** Resets HMD orientation in VR. */
 	void OnResetVR();
@@ -253,24 +367,6 @@ protected:
 	UFUNCTION()
 	void Reload();
 
-	UFUNCTION()
-	void BandageTimeOut();
-
-	UFUNCTION()
-	void PickaxeTimeOut();
-
-	UFUNCTION()
-	void RifleTimeOut();
-
-	UFUNCTION()
-	void ShotgunTimeOut();
-
-	UFUNCTION()
-	void RifleReloadTimeOut();
-
-	UFUNCTION()
-	void ShotgunReloadTimeOut();
-
 	UFUNCTION()
 	void HoldPickaxe();
 
@@ -329,33 +425,20 @@ public:
 
 	virtual void PostInitializeComponents() override;
 
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
 	virtual bool ReplicateSubobjects(class UActorChannel *Channel, class FOutBunch *Bunch, FReplicationFlags *RepFlags) override;
 
 	/* called when character touches something with its body */
 	UFUNCTION()
 	void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-	UFUNCTION()
-	void OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
 	virtual bool IsSupportedForNetworking() const override
 	{
 		return true;
 	}
 
 public:
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetIsWalkingTrue();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetIsWalkingFalse();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetIsRunningTrue();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetIsRunningFalse();
-
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerSetWalkingSpeed();
 
@@ -374,24 +457,6 @@ public:
 	UFUNCTION(Client, Reliable)
 	void ClientSetAimedInSpeed();
 
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetMovingLeft();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetMovingRight();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetMovingBackwards();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetMovingForwards();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerResetMovingRight();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerResetMovingForward();
-
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerSetBuildModeWall();
 
@@ -413,6 +478,10 @@ public:
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerReloadWeapons();
 
+	/* Holds the pooled weapon for any weapon id in the weapon table, the pickaxe is 0 */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerSwitchToWeapon(int WeaponId);
+
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerSwitchToPickaxe();
 
@@ -434,68 +503,20 @@ public:
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerAimHipFire();
 
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerShotgunTimeOut();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerPickaxeTimeOut();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerRifleTimeOut();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerBandageTimeOut();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerShotgunReloadTimeOut();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerRifleReloadTimeOut();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerApplyStormDamage();
-
 	UFUNCTION(Client, Reliable)
 	void ClientCameraAimIn();
 
 	UFUNCTION(Client, Reliable)
 	void ClientCameraAimOut();
 
+	/* Cosmetic only, clients spawn a local tracer for a projectile simulated by the server's projectile manager, using the bullet and definition of the weapon that fired */
 	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayPickaxeSwingAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayShootRifleAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayShootShotgunAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayShootRifleIronsightsAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayShootShotgunIronsightsAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayUseBandageAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayReloadRifleAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayReloadRifleIronsightsAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayReloadShotgunAnimation();
-
-	UFUNCTION(NetMulticast, Unreliable)
-	void NetMulticastPlayReloadShotgunIronsightsAnimation();
-
-	UFUNCTION(Client, Reliable)
-	void ClientDrawHitMarker();
+	void NetMulticastSpawnTracer(FVector_NetQuantize Location, FRotator Rotation, TSubclassOf<AProjectileActor> BulletClass, int WeaponId);
 
 private:
 	// Object creation can only happen after the character has finished being constructed
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
 
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "FortniteCloneCharacterMovement.generated.h"
+
+/**
+ * Character movement that carries the walk/run intent inside the saved move compressed flags,
+ * so locomotion state reaches the server with the regular ServerMove instead of separate reliable RPCs
+ */
+UCLASS()
+class FORTNITECLONE_API UFortniteCloneCharacterMovement : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UFortniteCloneCharacterMovement();
+
+	/* Set from input on the owning client, restored from the compressed flags on the server */
+	uint8 bWantsToWalk : 1;
+
+	uint8 bWantsToRun : 1;
+
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+
+	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+	/* Quantizes an acceleration component into the -90/0/90 blend space value used by the anim instance */
+	int8 QuantizeMoveAxis(float AccelerationAxis) const;
+
+protected:
+	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
+};
+
+class FSavedMove_FortniteClone : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	uint8 bSavedWantsToWalk : 1;
+
+	uint8 bSavedWantsToRun : 1;
+
+	virtual void Clear() override;
+
+	virtual uint8 GetCompressedFlags() const override;
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* Character, float MaxDelta) const override;
+
+	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, class FNetworkPredictionData_Client_Character& ClientData) override;
+
+	virtual void PrepMoveFor(ACharacter* Character) override;
+};
+
+class FNetworkPredictionData_Client_FortniteClone : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_FortniteClone(const UCharacterMovementComponent& ClientMovement);
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
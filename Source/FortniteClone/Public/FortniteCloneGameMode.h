@@ -4,9 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "BuildGrid.h"
+#include "FortniteCloneBotController.h"
 #include "FortniteCloneGameMode.generated.h"
 
 class AStormActor;
+class AProjectileManager;
+class AFortniteCloneCharacter;
+class AFortniteClonePlayerController;
+
+/* Damage waiting to be applied by the game mode at the end of the frame */
+struct FQueuedDamage
+{
+	TWeakObjectPtr<AFortniteCloneCharacter> Victim;
+	TWeakObjectPtr<AFortniteCloneCharacter> DamageCauser;
+	float Damage;
+};
 
 DECLARE_LOG_CATEGORY_EXTERN(LogMyServer, Log, All);
 
@@ -22,14 +35,23 @@ public:
 
 	AStormActor* CurrentStorm;
 
+	/* Simulates every projectile fired during the match */
+	UPROPERTY()
+	AProjectileManager* ProjectileManager;
+
 	virtual void BeginPlay() override;
 
 	virtual void StartPlay() override;
 
+	/* Writes the match profile CSV to the Saved/Profiling folder */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PostLogin(APlayerController *NewPlayer) override;
 
 	virtual void PreLogin(const FString& Options, const FString& Address, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage) override;
 
+	virtual void Logout(AController* Exiting) override;
+
 	UFUNCTION(NetMulticast, Reliable)
 	void NetMulticastSpawnStorm();
 
@@ -40,6 +62,80 @@ public:
 
 	UFUNCTION(Server, Reliable, WithValidation)
 	void TickInitializationClock();
+
+	/* Occupied building slots for the whole match */
+	FBuildGrid BuildGrid;
+
+	/* True if the slot is free and no player, the builder included, intrudes into the piece placed with PieceTransform */
+	bool CanBuildInSlot(uint64 SlotKey, const FTransform& PieceTransform) const;
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/* Queues damage against a character, applied with every other hit this frame, DamageCauser is null for the storm */
+	void QueueDamage(AFortniteCloneCharacter* Victim, float Damage, AFortniteCloneCharacter* DamageCauser);
+
+	/* Upper bound on deaths handled in one frame, the rest wait for the next frame */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Damage")
+	int MaxDeathsPerFrame;
+
+	/* Seconds between storm damage passes */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Damage")
+	float StormDamageInterval;
+
+	/* Tests every living character against the storm circle in one pass and queues damage for everyone outside it */
+	UFUNCTION()
+	void ApplyStormDamage();
+
+	/* Counts the replicated actors that are awake and dormant for stat FortniteClone */
+	void UpdateDormancyStats();
+
+	/* Spawns bots that play like players, used for load testing from fc.SpawnBots or -bots=N -botprofile=Name */
+	void SpawnBots(int Count, EBotProfile Profile);
+
+protected:
+	/* Finds the storm and starts the storm and initialization clocks */
+	void InitializeMatch();
+
+	/* Applies the queued damage and then handles deaths in one batch */
+	void ProcessDamageQueue();
+
+	/* Drops loot, switches the victim to spectating and gives kill credit */
+	void HandleDeath(AFortniteCloneCharacter* Victim, AFortniteCloneCharacter* Killer);
+
+	/* Leaves the victim's weapon in the world so it can be picked up */
+	void DropLoot(AFortniteCloneCharacter* Victim);
+
+	TArray<FQueuedDamage> DamageQueue;
+
+	/* Characters whose health reached zero, processed in order and bounded by MaxDeathsPerFrame */
+	TArray<FQueuedDamage> PendingDeaths;
+
+	/* Characters tested in the current storm pass, their horizontal positions are kept in parallel arrays for the distance test */
+	TArray<AFortniteCloneCharacter*> StormCandidates;
+
+	TArray<float> StormCandidateX;
+
+	TArray<float> StormCandidateY;
+
+	/* Counts every actor spawned and destroyed for the match profile, destroys are counted through each actor's OnDestroyed */
+	void OnActorSpawned(AActor* Actor);
+
+	UFUNCTION()
+	void OnActorDestroyed(AActor* Actor);
+
+	FDelegateHandle ActorSpawnedHandle;
+
+	/* Frame boundaries of the engine loop, the match profile times everything the game thread does in between */
+	void OnBeginFrame();
+
+	void OnEndFrame();
+
+	FDelegateHandle BeginFrameHandle;
+
+	FDelegateHandle EndFrameHandle;
+
+	/* Shooters with hit feedback waiting to be sent this frame */
+	TArray<AFortniteClonePlayerController*> HitFeedbackControllers;
 };
 
 
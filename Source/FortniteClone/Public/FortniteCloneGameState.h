@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "FortniteCloneGameState.generated.h"
+
+class UCharacterSignificanceManager;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPopulationCountChanged, int, Count);
+
+/**
+ * Match population kept by the server as players join, die and leave
+ * The counts only replicate when they change, the UI listens to the delegates instead of asking the server
+ */
+UCLASS()
+class FORTNITECLONE_API AFortniteCloneGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+
+public:
+	AFortniteCloneGameState();
+
+	/* Players still alive in the match */
+	UPROPERTY(ReplicatedUsing = OnRep_AliveCount)
+	int AliveCount;
+
+	/* Players who died or joined after the match started */
+	UPROPERTY(ReplicatedUsing = OnRep_SpectatorCount)
+	int SpectatorCount;
+
+	UPROPERTY(BlueprintAssignable, Category = "Count")
+	FOnPopulationCountChanged OnAliveCountChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Count")
+	FOnPopulationCountChanged OnSpectatorCountChanged;
+
+	UFUNCTION()
+	void OnRep_AliveCount();
+
+	UFUNCTION()
+	void OnRep_SpectatorCount();
+
+	/* Only called on the server when a player logs in, late joiners go straight to spectating */
+	void PlayerJoined(bool AsSpectator);
+
+	/* Only called on the server when a living player dies */
+	void PlayerDied();
+
+	/* Only called on the server when a bot dies, bots leave the match instead of spectating */
+	void BotDied();
+
+	/* Only called on the server when a player logs out */
+	void PlayerLeft(bool WasSpectator);
+
+	virtual void BeginPlay() override;
+
+	/* Slows down characters that matter least to the server's players or to the local view */
+	UPROPERTY()
+	UCharacterSignificanceManager* SignificanceManager;
+
+	/* Seconds between significance updates */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Significance")
+	float SignificanceUpdateInterval;
+
+	UFUNCTION()
+	void UpdateSignificance();
+
+private:
+	void SetCounts(int NewAliveCount, int NewSpectatorCount);
+};
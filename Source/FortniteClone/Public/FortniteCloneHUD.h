@@ -9,6 +9,8 @@
 class UUserWidget;
 class UTexture2D;
 class UWidgetAnimation;
+class UHUDViewModel;
+class UTransientWidgetPool;
 
 /**
  * 
@@ -32,7 +34,22 @@ public:
 
 	void DrawGameUI();
 
+	/* Cached HUD values for the widgets to bind to, updated when the values replicate */
+	UPROPERTY(BlueprintReadOnly, Category = "Widget")
+	UHUDViewModel* ViewModel;
+
+	/* Hit markers created when the HUD starts */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "HitMarker")
+	int HitMarkerPoolSize;
+
+	/* Most hit markers on screen at once, a new hit past this reuses the oldest marker */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "HitMarker")
+	int MaxHitMarkers;
+
 private:
+	/* Creates a widget and adds it to the viewport, widgets that should be driven by the view model are expected to be HUD widgets */
+	void AddGameWidget(TSubclassOf<UUserWidget> WidgetClass, bool UsesViewModel);
+
 	UTexture2D* CrosshairTexture;
 
 	UPROPERTY(EditAnywhere, Category = "Health")
@@ -62,4 +79,8 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Animations")
 	UWidgetAnimation* HitMarkerAnimation;
 
+	/* Recycled hit marker widgets, nothing is created per hit */
+	UPROPERTY()
+	UTransientWidgetPool* HitMarkerPool;
+
 };
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IpNetDriver.h"
+#include "FortniteCloneNetDriver.generated.h"
+
+/**
+ * Game net driver, the IP driver plus bandwidth accounting on the server
+ * Every RPC and every replication pass is measured per connection while FBandwidthAccounting is recording, and costs nothing when it isn't
+ */
+UCLASS(transient, config=Engine)
+class FORTNITECLONE_API UFortniteCloneNetDriver : public UIpNetDriver
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject = nullptr) override;
+
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+private:
+	/* Bits sent to the connection so far in the current stat period, including the packet still being filled */
+	static int64 GetSentBits(UNetConnection* Connection);
+
+	/* Characters, player states and pickups, the actors whose properties are broken down */
+	static bool IsAccountedClass(AActor* Actor);
+
+	int CountOpenChannels(AActor* Actor) const;
+
+	/* Sent bits of every client connection before the measured call, kept between calls to avoid reallocating */
+	TArray<int64> ConnectionBits;
+};
@@ -9,6 +9,26 @@
 class AFortniteCloneSpectator;
 class AStormActor;
 class AGameMode;
+
+/* Everything one player hit during a server frame, merged per target */
+USTRUCT()
+struct FHitFeedback
+{
+	GENERATED_BODY()
+
+	/* Flag set when the hit took the target's health to zero */
+	static const uint8 Killed = 1;
+
+	UPROPERTY()
+	AActor* Target;
+
+	UPROPERTY()
+	float Damage;
+
+	UPROPERTY()
+	uint8 Flags;
+};
+
 /**
  * 
  */
@@ -31,24 +51,13 @@ public:
 
 	TSubclassOf<AFortniteCloneSpectator> PlayerSpectatorClass;
 
-	UPROPERTY(Replicated)
-	int PlayerCount;
-
-	UPROPERTY(Replicated)
-	int SpectatorCount;
-
+	/* Read from the replicated game state, no request is sent to the server */
 	UFUNCTION(BlueprintPure, Category = "Count")
 	int GetPlayerCount();
 		
 	UFUNCTION(BlueprintPure, Category = "Count")
 	int GetSpectatorCount();
 
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerGetNumPlayers();
-
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerGetNumSpectators();
-
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerUpdateCountAfterDeath();
 
@@ -58,6 +67,16 @@ public:
 	UPROPERTY(Replicated)
 	bool SpawnAsSpectator;
 
+	/* Adds a hit by this player to the feedback sent at the end of the server frame */
+	void AddHitFeedback(AActor* Target, float Damage, bool Killed);
+
+	/* Sends the hits gathered this frame in one unreliable message, returns early if there were none */
+	void FlushHitFeedback();
+
+	/* Shows a hit marker for every target in the batch */
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveHitFeedback(const TArray<FHitFeedback>& Hits);
+
 	virtual bool IsSupportedForNetworking() const override
 	{
 		return true;
@@ -65,4 +84,6 @@ public:
 
 private:
 	virtual void BeginPlay() override;
+
+	TArray<FHitFeedback> PendingHitFeedback;
 };
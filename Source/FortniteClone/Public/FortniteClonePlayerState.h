@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerState.h"
+#include "ActionCooldowns.h"
 #include "FortniteClonePlayerState.generated.h"
 
+class UInventoryComponent;
+
 /**
  * 
  */
@@ -32,45 +35,35 @@ public:
 	UPROPERTY(Replicated)
 	bool AimedIn;
 
-	UPROPERTY(Replicated)
-	TArray<int> EquippedWeapons; //0 for pickaxe, 1 for assault rifle, 2 for shotgun
-
-	UPROPERTY(Replicated)
-	TArray<int> EquippedWeaponsAmmunition; //index 1 holds ammo for assault rifle, index 2 holds ammo for shotgun
-
-	//below will be used primarily for keeping track of how many bullets in a clip while switching between guns and building
-	UPROPERTY(Replicated)
-	TArray<int> EquippedWeaponsClips; //index 1 holds current magazine clip count for assault rifle, index 2 holds current magazine clip count for shotgun
-
-	UPROPERTY(Replicated)
-	TArray<int> MaterialCounts; //index 0 holds count for wood, index 1 holds count for stone, index 2 holds count for steel
+	/* Weapons, ammunition, clips, materials and bandages, only replicated to the owner */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+	UInventoryComponent* Inventory;
 
 	UPROPERTY(Replicated)
 	int CurrentWeapon; //0 for pickaxe, 1 for assault rifle, 2 for shotgun, -1 for non weapons like bandages
 
-	UPROPERTY(Replicated)
-	int BandageCount;
-
-	UPROPERTY(Replicated)
+	UPROPERTY(ReplicatedUsing = OnRep_KillCount)
 	int KillCount;
 
-	UPROPERTY(Replicated)
-	bool JustShotRifle; // used to prevent player from spamming rifle
+	UFUNCTION()
+	void OnRep_KillCount();
 
+	/* When the fire, swing, bandage and reload locks run out, only replicated to the owner */
 	UPROPERTY(Replicated)
-	bool JustShotShotgun; // used to prevent player from spamming shotgun
+	FActionCooldowns Cooldowns;
 
-	UPROPERTY(Replicated)
-	bool JustSwungPickaxe; //used to prevent player from spamming pickaxe
+	/* Server world time the cooldowns are measured against, the owning client gets the same clock through the game state */
+	float GetActionTime() const;
 
-	UPROPERTY(Replicated)
-	bool JustUsedBandage; //used to prevent player from spamming bandage and doing other things while reloading
+	bool IsActionActive(EPlayerAction Action) const;
 
-	UPROPERTY(Replicated)
-	bool JustReloadedRifle; //used to prevent player from doing other things while reloading
+	bool IsAnyActionActive() const;
 
-	UPROPERTY(Replicated)
-	bool JustReloadedShotgun; //used to prevent player from doing other things while reloading
+	void StartAction(EPlayerAction Action, float Duration);
+
+	void CancelAction(EPlayerAction Action);
+
+	void CancelAllActions();
 
 	virtual bool IsSupportedForNetworking() const override
 	{
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "FortniteCloneReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+class AFortniteCloneCharacter;
+
+/* How actors of a class are routed to the graph nodes */
+enum class EClassRepNodeMapping : uint32
+{
+	NotRouted, // only replicated through the per connection node
+	RelevantAllConnections, // always relevant node
+	Spatialize_Static, // grid node, never moves
+	Spatialize_Dynamic, // grid node, moves every frame
+	Spatialize_Dormancy, // grid node, treated as static while dormant and dynamic while awake
+	Equipment, // grid node while lying on the map, the holder's nodes once picked up
+};
+
+/**
+ * Replication graph for the dedicated server
+ * Pickups, harvestables and building pieces live in a 2D grid so a connection only gathers the cells around its viewer, the storm, game state and player states are always relevant,
+ * and every connection gets its own node for its controller and its pawn. Weapons and bandages are only ever in one place: the grid while nobody holds them,
+ * a dependent of the holder while in hand, and the holder's own connection node while stowed in the pool
+ */
+UCLASS(transient, config=Engine)
+class FORTNITECLONE_API UFortniteCloneReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	UFortniteCloneReplicationGraph();
+
+	virtual void InitGlobalActorClassSettings() override;
+
+	virtual void InitGlobalGraphNodes() override;
+
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	/* The graph of the world's net driver, null on clients */
+	static UFortniteCloneReplicationGraph* Get(const UWorld* World);
+
+	/* Moves a weapon or bandage in or out of the grid after it was picked up or dropped */
+	void RouteEquipment(AActor* Item);
+
+	/* Reroutes a character's pooled equipment and makes the item in hand replicate along with the character */
+	void UpdateHeldEquipment(AFortniteCloneCharacter* Character);
+
+	/* The graph ignores NetUpdateFrequency once an actor is added, this changes how many frames it waits between updates of the actor */
+	void SetUpdateFrequency(AActor* Actor, float NetUpdateFrequency);
+
+	/* Width of a grid cell in world units */
+	UPROPERTY(Config)
+	float GridCellSize;
+
+	/* Lowest X and Y of the map, the grid starts here */
+	UPROPERTY(Config)
+	float SpatialBiasX;
+
+	UPROPERTY(Config)
+	float SpatialBiasY;
+
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode;
+
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
+
+private:
+	/* Explicit routing for the game's classes, anything else falls back to its replication flags */
+	EClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	/* Fills in the cull distance and update period from the class defaults */
+	void InitClassReplicationInfo(FClassReplicationInfo& Info, UClass* Class, bool Spatialize, float ServerMaxTickRate) const;
+
+	TClassMap<EClassRepNodeMapping> ClassRepNodePolicies;
+
+	/* Weapons and bandages currently in the grid, the rest are held by someone */
+	TSet<AActor*> SpatializedEquipment;
+};
+
+/**
+ * Per connection node, gathers the connection's own controller, view target and pawn, and the stowed weapons and bandage only the pawn's owner needs
+ */
+UCLASS()
+class FORTNITECLONE_API UFortniteCloneReplicationGraphNode_ForConnection : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
+
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool WarnIfNotFound = true) override { return false; }
+
+	virtual void NotifyResetAllNetworkActors() override { }
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+	FActorRepListRefView ReplicationActorList;
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "HUDViewModel.generated.h"
+
+class APlayerController;
+class AFortniteCloneCharacter;
+class AFortniteClonePlayerState;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHUDFloatChanged, float, Value);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHUDCountChanged, int, Count);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHUDIndexedCountChanged, int, Index, int, Count);
+
+/**
+ * Values shown on the local player's HUD, cached so widgets don't have to look them up every frame
+ * Values are pushed in from the OnRep callbacks on the character, player state and inventory, widgets bind to the delegates
+ */
+UCLASS(BlueprintType)
+class FORTNITECLONE_API UHUDViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UHUDViewModel();
+
+	/* The view model of the HUD owned by the player controller, null for anyone who isn't a local player */
+	static UHUDViewModel* Get(APlayerController* PlayerController);
+
+	/* Reads every value once, used when the HUD is created after some values have already replicated */
+	void Refresh(AFortniteCloneCharacter* Character, AFortniteClonePlayerState* State);
+
+	void SetHealth(float NewHealth);
+
+	/* Material type is 0 for wood, 1 for stone, 2 for steel */
+	void SetMaterialCount(int MaterialType, int Count);
+
+	/* Spare ammunition, weapon type is an id from the weapon table, 1 for assault rifle, 2 for shotgun */
+	void SetAmmunitionCount(int WeaponType, int Count);
+
+	/* Bullets in the magazine, shown together with the spare ammunition */
+	void SetClipCount(int WeaponType, int Count);
+
+	void SetBandageCount(int Count);
+
+	void SetKillCount(int Count);
+
+	UFUNCTION(BlueprintPure, Category = "Health")
+	float GetHealth() const;
+
+	UFUNCTION(BlueprintPure, Category = "Material")
+	int GetMaterialCount(int MaterialType) const;
+
+	/* Spare ammunition plus what is in the magazine */
+	UFUNCTION(BlueprintPure, Category = "Items")
+	int GetAmmunitionCount(int WeaponType) const;
+
+	/* One past the highest weapon type with an ammunition count */
+	UFUNCTION(BlueprintPure, Category = "Items")
+	int GetWeaponCount() const;
+
+	UFUNCTION(BlueprintPure, Category = "Items")
+	int GetBandageCount() const;
+
+	UFUNCTION(BlueprintPure, Category = "Count")
+	int GetKillCount() const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Health")
+	FOnHUDFloatChanged OnHealthChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Material")
+	FOnHUDIndexedCountChanged OnMaterialCountChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Items")
+	FOnHUDIndexedCountChanged OnAmmunitionCountChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Items")
+	FOnHUDCountChanged OnBandageCountChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Count")
+	FOnHUDCountChanged OnKillCountChanged;
+
+private:
+	float Health;
+
+	int MaterialCounts[3];
+
+	/* Indexed by weapon type, sized from the weapon table */
+	TArray<int> AmmunitionCounts;
+
+	TArray<int> ClipCounts;
+
+	int BandageCount;
+
+	int KillCount;
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HUDWidget.generated.h"
+
+class UHUDViewModel;
+
+/**
+ * Base class for the HUD widgets, subscribes to the HUD view model when constructed and forwards every change to the blueprint events
+ * Widgets only redraw when a value changes instead of polling the character and player state from property bindings every frame
+ */
+UCLASS(Abstract)
+class FORTNITECLONE_API UHUDWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeConstruct() override;
+
+	virtual void NativeDestruct() override;
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Health")
+	void OnHealthChanged(float Health);
+
+	/* Material type is 0 for wood, 1 for stone, 2 for steel */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Material")
+	void OnMaterialCountChanged(int MaterialType, int Count);
+
+	/* Count is the spare ammunition plus what is in the magazine */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Items")
+	void OnAmmunitionCountChanged(int WeaponType, int Count);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Items")
+	void OnBandageCountChanged(int Count);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Count")
+	void OnKillCountChanged(int Count);
+
+	/* The view model this widget is subscribed to, null before construction or when there is no local HUD */
+	UPROPERTY(BlueprintReadOnly, Category = "Widget")
+	UHUDViewModel* ViewModel;
+
+private:
+	UFUNCTION()
+	void HandleHealthChanged(float Value);
+
+	UFUNCTION()
+	void HandleMaterialCountChanged(int Index, int Count);
+
+	UFUNCTION()
+	void HandleAmmunitionCountChanged(int Index, int Count);
+
+	UFUNCTION()
+	void HandleBandageCountChanged(int Count);
+
+	UFUNCTION()
+	void HandleKillCountChanged(int Count);
+};
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/NetSerialization.h"
+#include "InventoryComponent.generated.h"
+
+class UInventoryComponent;
+
+/* Kind of count an inventory entry holds, the entry index is the weapon type or material type */
+UENUM()
+enum class EInventoryItem : uint8
+{
+	Weapon, // 1 if the weapon type is owned
+	Ammunition, // spare bullets per weapon type
+	Clip, // bullets in the magazine per weapon type
+	Material, // 0 wood, 1 stone, 2 steel
+	Bandage
+};
+
+/* One count in the inventory, replicated on its own when it changes */
+USTRUCT()
+struct FORTNITECLONE_API FInventoryEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	FInventoryEntry()
+		: Item(EInventoryItem::Weapon)
+		, Index(0)
+		, Count(0)
+	{
+	}
+
+	UPROPERTY()
+	EInventoryItem Item;
+
+	UPROPERTY()
+	uint8 Index;
+
+	UPROPERTY()
+	int32 Count;
+
+	void PostReplicatedAdd(const struct FInventoryList& InArraySerializer);
+
+	void PostReplicatedChange(const struct FInventoryList& InArraySerializer);
+};
+
+/* Every count in the inventory, only the entries marked dirty are sent */
+USTRUCT()
+struct FORTNITECLONE_API FInventoryList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FInventoryEntry> Entries;
+
+	/* Component holding the list, told about every entry that arrives from the server */
+	UInventoryComponent* Owner;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FInventoryEntry, FInventoryList>(Entries, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryList> : public TStructOpsTypeTraitsBase2<FInventoryList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * Weapons, ammunition, magazine counts, materials and bandages owned by a player
+ * Only the owning connection receives the inventory, everyone else sees the held item through the character
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class FORTNITECLONE_API UInventoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UInventoryComponent();
+
+	/* Returns 0 for anything the player has never had */
+	int GetCount(EInventoryItem Item, int Index) const;
+
+	/* Only called on the server, marks the entry dirty if the count changed */
+	void SetCount(EInventoryItem Item, int Index, int Count);
+
+	void AddCount(EInventoryItem Item, int Index, int Delta);
+
+	bool HasWeapon(int WeaponType) const;
+
+	/* Pushes a changed count to the owning player's HUD */
+	void NotifyEntryChanged(const FInventoryEntry& Entry);
+
+	UPROPERTY(Replicated)
+	FInventoryList Items;
+
+protected:
+	// Called when the game starts
+	virtual void BeginPlay() override;
+
+private:
+	FInventoryEntry* FindEntry(EInventoryItem Item, int Index);
+
+	const FInventoryEntry* FindEntry(EInventoryItem Item, int Index) const;
+};
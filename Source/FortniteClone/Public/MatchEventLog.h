@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Templates/Atomic.h"
+
+class APawn;
+class FRunnableThread;
+class IFileHandle;
+
+/* Gameplay events kept for analytics after the match */
+enum class EMatchEvent : uint8
+{
+	Kill, // subject killed object, no subject for the storm
+	Damage, // subject hit object for value, no subject for the storm
+	Build, // kind is the piece, 0 wall 1 ramp 2 floor, variant is the material
+	Pickup, // kind is the inventory item, variant the weapon type, value the amount
+	StormPhase, // value is the radius the circle shrinks to, location its center
+	Spectate, // subject started spectating
+	Count
+};
+
+/* One event as stored in the file, player ids are -1 when there is no player */
+struct FMatchEventRecord
+{
+	/* Seconds since logging started */
+	float Time;
+
+	EMatchEvent Type;
+
+	uint8 Kind;
+
+	uint8 Variant;
+
+	uint8 Padding;
+
+	int32 Subject;
+
+	int32 Object;
+
+	float Value;
+
+	float X;
+
+	float Y;
+
+	float Z;
+};
+static_assert(sizeof(FMatchEventRecord) == 32, "match event records are written to disk as they are");
+
+/**
+ * Binary log of match events that replaces formatting strings and writing to the log on gameplay code paths
+ * Each thread recording events gets its own single producer ring, so recording is a copy into the ring and never takes a lock,
+ * and a background thread moves the rings into the file every FlushInterval seconds. The commandlet MatchEventLog decodes a file to CSV
+ */
+class FORTNITECLONE_API FMatchEventLog
+{
+public:
+	static FMatchEventLog& Get();
+
+	/* Opens the file and starts the writer thread, returns false if the file could not be created */
+	bool Start(const FString& Path);
+
+	/* Writes everything recorded so far, stops the writer thread and closes the file */
+	void Stop();
+
+	bool IsRunning() const;
+
+	/* Safe to call from any thread, drops the event if logging isn't running or the thread's ring is full */
+	void Record(EMatchEvent Type, uint8 Kind, uint8 Variant, int32 Subject, int32 Object, float Value, const FVector& Location);
+
+	/* Player id of whoever controls the pawn, -1 for no pawn or a pawn without a player state */
+	static int32 GetPlayerId(const APawn* Pawn);
+
+	/* Writes one CSV row per event, sorted by time, returns false if the log can't be read or the CSV can't be written */
+	static bool DecodeToCsv(const FString& LogPath, const FString& CsvPath);
+
+	/* Seconds between writes to the file */
+	float FlushInterval;
+
+private:
+	/* Ring of events recorded by one thread, only that thread moves Head and only the writer thread moves Tail */
+	struct FEventRing
+	{
+		FEventRing();
+
+		static const uint32 Capacity = 4096;
+
+		FMatchEventRecord Records[Capacity];
+
+		TAtomic<uint32> Head;
+
+		TAtomic<uint32> Tail;
+	};
+
+	class FWriter;
+
+	FEventRing* GetThreadRing();
+
+	/* Moves every ring into the file, called from the writer thread */
+	void Drain();
+
+	/* Thread local slot holding each thread's ring */
+	uint32 RingSlot;
+
+	/* Rings of every thread that has recorded an event, only locked when a thread records its first event and while draining */
+	TArray<TUniquePtr<FEventRing>> Rings;
+
+	FCriticalSection RingsLock;
+
+	/* Records copied out of the rings, reused between drains */
+	TArray<FMatchEventRecord> Batch;
+
+	IFileHandle* File;
+
+	FWriter* Writer;
+
+	FRunnableThread* WriterThread;
+
+	FThreadSafeBool Running;
+
+	double StartTime;
+
+	FMatchEventLog();
+};
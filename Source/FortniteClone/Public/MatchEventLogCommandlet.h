@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MatchEventLogCommandlet.generated.h"
+
+/**
+ * Decodes a match event log written by the server to CSV
+ * Usage: UE4Editor-Cmd FortniteClone -run=MatchEventLog -in=<Events.fcevents> [-out=<Events.csv>]
+ */
+UCLASS()
+class FORTNITECLONE_API UMatchEventLogCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMatchEventLogCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
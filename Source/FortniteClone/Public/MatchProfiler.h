@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Server code paths timed every frame for the match profile */
+enum class EProfiledScope : uint8
+{
+	CharacterTick,
+	FireWeapons,
+	BuildStructures,
+	CharacterOverlap,
+	ProjectileOverlap,
+	ProjectileSimulation,
+	StormDamage,
+	StormTick,
+	Count
+};
+
+/**
+ * Game thread time, time spent in each profiled scope and actor spawn and destroy counts for every server frame of a match
+ * Works in every build configuration, unlike stat FortniteClone, and is written out as one CSV of percentiles when the match ends
+ */
+class FORTNITECLONE_API FMatchProfiler
+{
+public:
+	/* Times the enclosing block into the current frame */
+	struct FScope
+	{
+		FScope(EProfiledScope InScope);
+		~FScope();
+
+	private:
+		EProfiledScope Scope;
+		double StartTime;
+	};
+
+	static FMatchProfiler& Get();
+
+	/* Starts a new match, drops everything recorded so far */
+	void Reset();
+
+	void AddScopeTime(EProfiledScope Scope, double Seconds);
+
+	void CountSpawn();
+
+	void CountDestroy();
+
+	/* Marks the start of an engine frame, bound to the start of the engine loop */
+	void BeginFrame();
+
+	/* Stores the frame's game thread time, the wall time since BeginFrame without the time spent waiting for the tick rate cap, and starts the next frame */
+	void EndFrame();
+
+	/* Writes mean, p50, p95, p99 and max of every metric, returns false if the file could not be written */
+	bool WriteCsv(const FString& Path) const;
+
+	bool IsEmpty() const;
+
+private:
+	static const int ScopeCount = (int)EProfiledScope::Count;
+
+	/* Milliseconds of each frame, one array per metric so percentiles sort a single array */
+	TArray<float> FrameTimes;
+
+	TArray<float> ScopeTimes[ScopeCount];
+
+	TArray<float> Spawns;
+
+	TArray<float> Destroys;
+
+	/* Totals for the frame in progress */
+	double CurrentScopeSeconds[ScopeCount];
+
+	int CurrentSpawns;
+
+	int CurrentDestroys;
+
+	/* Start of the frame in progress, 0 until the first frame begins */
+	double FrameStartTime;
+
+	FMatchProfiler();
+};
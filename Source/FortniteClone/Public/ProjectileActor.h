@@ -11,6 +11,7 @@ class UProjectileMovementComponent;
 class USphereComponent;
 class AWeaponActor;
 class AFortniteCloneCharacter;
+class UWeaponDefinition;
 
 UCLASS()
 class FORTNITECLONE_API AProjectileActor : public AActor
@@ -58,4 +59,13 @@ public:
 
 	UFUNCTION()
 	void SelfDestruct();
+
+	/* Applies a projectile hit against OtherActor on the server, returns true if the projectile stops there, actors it doesn't know about only stop it when they block it */
+	static bool ResolveHit(AActor* OtherActor, float Damage, int ProjectileType, AFortniteCloneCharacter* WeaponHolder, AWeaponActor* Weapon, bool bBlockingHit = false);
+
+	/* Speed of a projectile of BulletClass fired by a weapon, the definition wins wherever it sets one */
+	static float GetProjectileSpeed(TSubclassOf<AProjectileActor> BulletClass, const UWeaponDefinition* Definition);
+
+	/* Queues damage against a character with the game mode, which handles the hitmarker and the kill */
+	static void DamageCharacter(AFortniteCloneCharacter* FortniteCloneCharacter, float Damage, AFortniteCloneCharacter* WeaponHolder);
 };
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ProjectileManager.generated.h"
+
+class AProjectileActor;
+class AWeaponActor;
+class UWeaponDefinition;
+class AFortniteCloneCharacter;
+
+/* Entry in the expiry queue, a slot is only expired if its generation still matches */
+struct FProjectileExpiry
+{
+	float ExpireTime;
+	int Slot;
+	uint16 Generation;
+
+	bool operator<(const FProjectileExpiry& Other) const
+	{
+		return ExpireTime < Other.ExpireTime;
+	}
+};
+
+/**
+ * Server only simulation of every live projectile
+ * Projectiles are kept in parallel arrays instead of one actor each, advanced with a sphere sweep per tick and expired from a min-heap ordered by expiry time
+ */
+UCLASS(config=Game)
+class FORTNITECLONE_API AProjectileManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	AProjectileManager();
+
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	/* Starts simulating a projectile using the lifespan and radius of the bullet class defaults, and the damage and speed of the weapon definition unless it leaves them to the bullet */
+	void FireProjectile(TSubclassOf<AProjectileActor> BulletClass, const UWeaponDefinition* Definition, const FVector& Location, const FRotator& Rotation, AFortniteCloneCharacter* Shooter, AWeaponActor* Weapon);
+
+	/* Number of projectiles currently being simulated */
+	int GetLiveProjectileCount() const;
+
+	/* Tests a swept sphere against every character's capsule as it was RewindTime seconds ago, returns the first character hit and the fraction along the segment */
+	AFortniteCloneCharacter* RewindAndTest(const FVector& Start, const FVector& End, float Radius, float RewindTime, AActor* IgnoredCharacter, float& OutHitTime) const;
+
+	/* Longest a hit may be rewound for a high ping shooter, in seconds */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Lag Compensation")
+	float MaxRewindTime;
+
+private:
+	int AllocateSlot();
+
+	void FreeSlot(int Slot);
+
+	/* Pops every expired projectile off the expiry queue */
+	void ExpireProjectiles(float Now);
+
+	/* Projectile data, indexed by slot */
+	TArray<FVector> Locations;
+
+	TArray<FVector> Velocities;
+
+	TArray<float> Radii;
+
+	/* Object type and channel responses of the bullet class, used for the world sweep */
+	TArray<TEnumAsByte<ECollisionChannel>> CollisionChannels;
+
+	TArray<FCollisionResponseParams> ResponseParams;
+
+	TArray<float> Damages;
+
+	TArray<int> ProjectileTypes;
+
+	/* How far back in time characters are tested for this projectile, the shooter's ping when it was fired */
+	TArray<float> RewindTimes;
+
+	TArray<TWeakObjectPtr<AFortniteCloneCharacter>> Shooters;
+
+	TArray<TWeakObjectPtr<AWeaponActor>> Weapons;
+
+	TArray<uint16> Generations;
+
+	TArray<bool> LiveSlots;
+
+	/* Slots that can be reused */
+	TArray<int> FreeSlots;
+
+	/* Min-heap of expiry times */
+	TArray<FProjectileExpiry> ExpiryQueue;
+
+	int LiveProjectileCount;
+
+	/* Characters alive this tick, gathered once for the rewind tests */
+	TArray<AFortniteCloneCharacter*> Characters;
+};
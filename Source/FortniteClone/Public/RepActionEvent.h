@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RepActionEvent.generated.h"
+
+/* Montages a character plays for everyone to see, fits in 4 bits */
+UENUM()
+enum class ECharacterMontage : uint8
+{
+	None,
+	PickaxeSwing,
+	ShootRifle,
+	ShootShotgun,
+	ShootRifleIronsights,
+	ShootShotgunIronsights,
+	UseBandage,
+	ReloadRifle,
+	ReloadRifleIronsights,
+	ReloadShotgun,
+	ReloadShotgunIronsights
+};
+
+/**
+ * Last montage the server started on a character, replicated instead of a multicast per montage
+ * The counter changes on every start so the same montage twice in a row still replicates, the start time
+ * lets clients that only just received the character skip a montage that has already finished
+ */
+USTRUCT()
+struct FORTNITECLONE_API FRepActionEvent
+{
+	GENERATED_BODY()
+
+	FRepActionEvent();
+
+	/* Records a new montage start at the given server time */
+	void Start(ECharacterMontage NewMontage, float Time);
+
+	ECharacterMontage GetMontage() const;
+
+	float GetStartTime() const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FRepActionEvent& Other) const
+	{
+		return Packed == Other.Packed && StartTime == Other.StartTime;
+	}
+
+	bool operator!=(const FRepActionEvent& Other) const
+	{
+		return !(*this == Other);
+	}
+
+private:
+	/* Montage in the low 4 bits, rolling counter in the high 4 bits */
+	uint8 Packed;
+
+	float StartTime;
+};
+
+template<>
+struct TStructOpsTypeTraits<FRepActionEvent> : public TStructOpsTypeTraitsBase2<FRepActionEvent>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RepAnimState.generated.h"
+
+/**
+ * Everything the third person anim instance needs from a character, packed into a single 30 bit word
+ * Layout from the low bit: walking, running, holding weapon, aimed in (1 bit each), holding weapon type (2 bits),
+ * move X and move Y (2 bits each, -90/0/90), aim pitch and aim yaw (10 bits each over -90 to 90 degrees)
+ */
+USTRUCT()
+struct FORTNITECLONE_API FRepAnimState
+{
+	GENERATED_BODY()
+
+	FRepAnimState();
+
+	/* Packs the character's anim properties, returns true if the packed value changed */
+	bool Pack(bool IsWalking, bool IsRunning, bool HoldingWeapon, bool AimedIn, int HoldingWeaponType, float MoveX, float MoveY, float AimPitch, float AimYaw);
+
+	bool IsWalking() const;
+
+	bool IsRunning() const;
+
+	bool HoldingWeapon() const;
+
+	bool AimedIn() const;
+
+	int HoldingWeaponType() const;
+
+	float MoveX() const;
+
+	float MoveY() const;
+
+	float AimPitch() const;
+
+	float AimYaw() const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FRepAnimState& Other) const
+	{
+		return Packed == Other.Packed;
+	}
+
+	bool operator!=(const FRepAnimState& Other) const
+	{
+		return Packed != Other.Packed;
+	}
+
+private:
+	uint32 Packed;
+};
+
+template<>
+struct TStructOpsTypeTraits<FRepAnimState> : public TStructOpsTypeTraitsBase2<FRepAnimState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
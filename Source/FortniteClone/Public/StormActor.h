@@ -6,7 +6,38 @@
 #include "GameFramework/Actor.h"
 #include "StormActor.generated.h"
 
+/* One shrink of the storm circle, replicated once when the phase starts and evaluated locally from server time */
+USTRUCT()
+struct FStormPhase
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize Center;
 
+	/* Radius held until StartTime */
+	UPROPERTY()
+	float StartRadius;
+
+	/* Radius reached at EndTime and held afterwards */
+	UPROPERTY()
+	float EndRadius;
+
+	UPROPERTY()
+	float StartTime;
+
+	UPROPERTY()
+	float EndTime;
+
+	FStormPhase()
+		: Center(FVector::ZeroVector)
+		, StartRadius(0)
+		, EndRadius(0)
+		, StartTime(0)
+		, EndTime(0)
+	{
+	}
+};
 
 UCLASS()
 class FORTNITECLONE_API AStormActor : public AActor
@@ -28,22 +59,44 @@ public:
 	UPROPERTY(Replicated)
 	float Damage;
 
-	UPROPERTY(Replicated)
-	bool IsShrinking;
+	/* Current phase of the storm, the only replicated description of its size */
+	UPROPERTY(ReplicatedUsing = OnRep_Phase)
+	FStormPhase Phase;
 
-	UPROPERTY(Replicated)
-	FVector SizeScale;
+	/* Seconds the circle holds its size before each shrink */
+	UPROPERTY(EditDefaultsOnly, Category = "Storm")
+	float WaitDuration;
 
-	UPROPERTY()
-	int Stage;
+	/* Seconds each shrink takes */
+	UPROPERTY(EditDefaultsOnly, Category = "Storm")
+	float ShrinkDuration;
+
+	/* Fraction of the radius left after each shrink */
+	UPROPERTY(EditDefaultsOnly, Category = "Storm")
+	float ShrinkRatio;
+
+	/* Radius of the circle at its starting scale, measured from the mesh bounds */
+	float InitialRadius;
+
+	FVector InitialScale;
+
+	/* Radius of the safe circle right now, evaluated from the phase and synced server time */
+	float GetCurrentRadius() const;
+
+	/* True if the location is inside the safe circle */
+	bool IsInSafeZone(const FVector& Location) const;
+
+	UFUNCTION()
+	void OnRep_Phase();
 
 	virtual bool IsSupportedForNetworking() const override
 	{
 		return true;
 	}
 
-	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerSetIsShrinking();
+	/* Starts the next wait and shrink of the circle */
+	UFUNCTION()
+	void ServerStartNextPhase();
 
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerSetNewDamage();
@@ -51,4 +104,9 @@ public:
 	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerStartStorm();
 
+private:
+	float GetServerTime() const;
+
+	/* Scales the storm mesh to the current radius, only for visuals on clients */
+	void UpdateStormScale();
 };
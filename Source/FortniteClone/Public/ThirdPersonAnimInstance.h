@@ -16,45 +16,45 @@ class UThirdPersonAnimInstance : public UAnimInstance
 public:
 	UThirdPersonAnimInstance();
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	bool IsRunning;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	bool IsWalking;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	bool HoldingWeapon;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	bool AimedIn;
 
 	/* Value for blend poses by int in blueprint */
 	/* 0 for not holding anything, 1 for holding weapon on hip, 2 for holding weapon aimed into ironsights */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	int HoldingWeaponType;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float Speed;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float AimPitch;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float AimYaw;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float InterpSpeed;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float WalkingX;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float WalkingY;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float RunningX;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Generic")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generic")
 	float RunningY;
 
 	virtual bool IsSupportedForNetworking() const override
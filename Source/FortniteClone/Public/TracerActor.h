@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TracerActor.generated.h"
+
+class UStaticMeshComponent;
+class AProjectileActor;
+class UWeaponDefinition;
+
+/**
+ * Client side tracer for a projectile simulated by the server's projectile manager
+ * Only draws the bullet's mesh and moves it in a straight line, it has no collision and never replicates
+ */
+UCLASS()
+class FORTNITECLONE_API ATracerActor : public AActor
+{
+	GENERATED_BODY()
+	
+public:	
+	// Sets default values for this actor's properties
+	ATracerActor();
+
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	UPROPERTY(VisibleAnywhere, Category = "Tracer")
+	UStaticMeshComponent* MeshComponent;
+
+	/* Takes the mesh, speed and lifespan of the bullet class and weapon definition the shot was fired with */
+	void Initialize(TSubclassOf<AProjectileActor> BulletClass, const UWeaponDefinition* Definition);
+
+private:
+	FVector Velocity;
+};
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "TransientWidgetPool.generated.h"
+
+class APlayerController;
+class UUserWidget;
+class UWidgetAnimation;
+
+/**
+ * Fixed set of short-lived HUD widgets such as hit markers that are shown, hidden and shown again instead of created per use
+ * Every widget stays in the viewport collapsed while it is free, a shown widget is freed once its animation has finished
+ */
+UCLASS()
+class FORTNITECLONE_API UTransientWidgetPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UTransientWidgetPool();
+
+	/* Creates the first PreallocateCount widgets up front, the pool never holds more than MaxCount */
+	void Init(APlayerController* InOwningPlayer, TSubclassOf<UUserWidget> InWidgetClass, int PreallocateCount, int InMaxCount);
+
+	/* Shows a free widget and plays its animation, reuses the oldest shown widget when the pool is full */
+	UUserWidget* Show();
+
+	/* Frees every widget whose animation has finished */
+	void Update(float Now);
+
+	/* Seconds a widget stays up when its class has no animation */
+	float DefaultLifetime;
+
+private:
+	/* Adds a new collapsed widget to the viewport, returns its index or INDEX_NONE */
+	int CreatePooledWidget();
+
+	void Release(int Index);
+
+	UPROPERTY()
+	APlayerController* OwningPlayer;
+
+	TSubclassOf<UUserWidget> WidgetClass;
+
+	int MaxCount;
+
+	UPROPERTY()
+	TArray<UUserWidget*> Widgets;
+
+	/* Animation played by each widget, null if the widget class has none */
+	UPROPERTY()
+	TArray<UWidgetAnimation*> Animations;
+
+	/* World time each widget is freed at, 0 while free */
+	TArray<float> ReleaseTimes;
+};
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ActionCooldowns.h"
+#include "RepActionEvent.h"
+#include "WeaponDefinition.generated.h"
+
+class AWeaponActor;
+
+/**
+ * How a weapon fires and reloads, one asset per weapon under Content/Weapons, loaded by the asset manager at startup
+ * A weapon actor is tied to its definition by its WeaponType, which is the definition's WeaponId
+ * Damage, ProjectileSpeed and MagazineSize of 0 keep the value set on the bullet or weapon blueprint
+ */
+UCLASS(BlueprintType)
+class FORTNITECLONE_API UWeaponDefinition : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UWeaponDefinition();
+
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	/* Index into the weapon table and the weapon type of the actors using this definition, ids should be kept small and contiguous */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon")
+	int32 WeaponId;
+
+	/* False for weapons without a magazine, such as the pickaxe */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon")
+	bool UsesAmmunition;
+
+	/* Damage of each projectile */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Firing")
+	float Damage;
+
+	/* Seconds between shots */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Firing")
+	float FireInterval;
+
+	/* Half angle in degrees of the cone each projectile is fired into */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Firing")
+	float Spread;
+
+	/* Projectiles fired per shot */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Firing")
+	int32 PelletCount;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Firing")
+	float ProjectileSpeed;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ammunition")
+	int32 MagazineSize;
+
+	/* Seconds a reload takes */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ammunition")
+	float ReloadTime;
+
+	/* Cooldown started by a shot, weapons sharing one can't be fired right after each other */
+	UPROPERTY(EditDefaultsOnly, Category = "Actions")
+	EPlayerAction FireAction;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Actions")
+	EPlayerAction ReloadAction;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Animation")
+	ECharacterMontage FireMontage;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Animation")
+	ECharacterMontage AimedFireMontage;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Animation")
+	ECharacterMontage ReloadMontage;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Animation")
+	ECharacterMontage AimedReloadMontage;
+
+	int GetMagazineSize(const AWeaponActor* Weapon) const;
+};